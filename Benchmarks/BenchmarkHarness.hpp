@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fmt/format.h>
+
+namespace Cango::Benchmarks {
+	/// @brief 防止编译器优化掉没有副作用的计算
+	template <typename T>
+	void DoNotOptimize(T&& value) noexcept { asm volatile("" : : "g"(&value) : "memory"); }
+
+	/// @brief 已经排序的样本中给定比例处的值，样本不能为空
+	template <typename T>
+	[[nodiscard]] T Percentile(const std::vector<T>& sortedSamples, const double ratio) noexcept {
+		return sortedSamples[static_cast<std::size_t>(ratio * static_cast<double>(sortedSamples.size() - 1))];
+	}
+
+	enum class Direction {
+		LowerIsBetter,
+		HigherIsBetter
+	};
+
+	struct BenchmarkResult {
+		std::string Name{};
+		std::string Metric{};
+		std::string Unit{};
+		double Value{};
+		Direction Better{Direction::LowerIsBetter};
+	};
+
+	/// @brief 内置的基准测试框架，负责筛选、计时、统计分位数和输出 JSON 。
+	///	@details
+	///		命令行参数：
+	///			--output <文件> 把结果写入 JSON 文件，默认只输出到控制台；
+	///			--filter <文本> 只运行名称包含该文本的测试；
+	///			--quick 缩短计时，用于检查基准测试本身是否能正常运行。
+	class BenchmarkSuite {
+		using Clock = std::chrono::steady_clock;
+
+		std::vector<BenchmarkResult> Results{};
+		std::string OutputFile{};
+		std::string Filter{};
+		std::chrono::milliseconds MinRunDuration{200};
+		std::size_t RepeatCount{5};
+
+	public:
+		[[nodiscard]] bool ParseArguments(const int argc, const char* const* argv) {
+			for (int index = 1; index < argc; ++index) {
+				const std::string_view argument{argv[index]};
+				if (argument == "--output" && index + 1 < argc) OutputFile = argv[++index];
+				else if (argument == "--filter" && index + 1 < argc) Filter = argv[++index];
+				else if (argument == "--quick") {
+					MinRunDuration = std::chrono::milliseconds{20};
+					RepeatCount = 1;
+				}
+				else {
+					fmt::print(stderr, "未知参数：{}\n用法：{} [--output 文件] [--filter 文本] [--quick]\n", argument, argv[0]);
+					return false;
+				}
+			}
+			return true;
+		}
+
+		[[nodiscard]] bool IsQuick() const noexcept { return RepeatCount == 1; }
+
+		/// @brief 名称是否通过了筛选
+		[[nodiscard]] bool IsEnabled(const std::string_view name) const noexcept {
+			return Filter.empty() || name.find(Filter) != std::string_view::npos;
+		}
+
+		void Record(
+			std::string name,
+			std::string metric,
+			const double value,
+			std::string unit,
+			const Direction better = Direction::LowerIsBetter) {
+			fmt::print("{:<52} {:<14} {:>14.2f} {}\n", name, metric, value, unit);
+			Results.push_back({std::move(name), std::move(metric), std::move(unit), value, better});
+		}
+
+		/// @brief 测量每次调用的耗时
+		///	@details 先倍增调用次数直到单轮耗时超过 MinRunDuration ，再重复若干轮取中位数，减少偶发的干扰。
+		void MeasureNanoseconds(const std::string_view name, auto&& operation) {
+			if (!IsEnabled(name)) return;
+
+			std::size_t iterations = 1;
+			const auto run = [&operation](const std::size_t count) {
+				const auto begin = Clock::now();
+				for (std::size_t index = 0; index < count; ++index) operation();
+				return Clock::now() - begin;
+			};
+			// 被优化成空操作的测试耗时始终为零，需要限制倍增的次数
+			constexpr std::size_t max_iterations = std::size_t{1} << 32;
+			while (iterations < max_iterations && run(iterations) < MinRunDuration / 4) iterations *= 2;
+			iterations *= 4;
+
+			std::vector<double> samples{};
+			for (std::size_t repeat = 0; repeat < RepeatCount; ++repeat) {
+				const auto duration = std::chrono::duration<double, std::nano>(run(iterations)).count();
+				samples.push_back(duration / static_cast<double>(iterations));
+			}
+			std::ranges::sort(samples);
+			Record(std::string{name}, "ns_per_op", samples[samples.size() / 2], "ns");
+		}
+
+		/// @brief 记录样本的分位数，样本会被排序
+		void RecordPercentiles(const std::string_view name, std::vector<double>& samples, const std::string_view unit) {
+			if (samples.empty()) return;
+			std::ranges::sort(samples);
+			Record(std::string{name}, "p50", Percentile(samples, 0.5), std::string{unit});
+			Record(std::string{name}, "p90", Percentile(samples, 0.9), std::string{unit});
+			Record(std::string{name}, "p99", Percentile(samples, 0.99), std::string{unit});
+			Record(std::string{name}, "p999", Percentile(samples, 0.999), std::string{unit});
+		}
+
+		/// @brief 以吞吐量的形式记录结果，越大越好
+		void RecordThroughput(const std::string_view name, const std::string_view metric, const double value, const std::string_view unit) {
+			Record(std::string{name}, std::string{metric}, value, std::string{unit}, Direction::HigherIsBetter);
+		}
+
+		/// @brief 单轮计时的时长，供自行计时的测试使用
+		[[nodiscard]] std::chrono::milliseconds GetRunDuration() const noexcept { return MinRunDuration * RepeatCount; }
+
+		/// @brief 把结果写入 JSON 文件，没有指定输出文件时直接返回成功
+		[[nodiscard]] bool WriteJson() const {
+			if (OutputFile.empty()) return true;
+
+			std::FILE* file = std::fopen(OutputFile.c_str(), "w");
+			if (file == nullptr) {
+				fmt::print(stderr, "无法写入文件：{}\n", OutputFile);
+				return false;
+			}
+
+			fmt::print(file, "{{\n  \"suite\": \"Cango.CommonUtils\",\n  \"timestamp\": {},\n  \"results\": [\n", std::time(nullptr));
+			for (std::size_t index = 0; index < Results.size(); ++index) {
+				const auto& result = Results[index];
+				// JSON 不支持 inf 和 nan ，这类结果写为 null
+				const auto value = std::isfinite(result.Value) ? fmt::format("{}", result.Value) : std::string{"null"};
+				fmt::print(file, "    {{\"name\": \"{}\", \"metric\": \"{}\", \"value\": {}, \"unit\": \"{}\", \"better\": \"{}\"}}{}\n",
+					result.Name, result.Metric, value, result.Unit,
+					result.Better == Direction::LowerIsBetter ? "lower" : "higher",
+					index + 1 == Results.size() ? "" : ",");
+			}
+			fmt::print(file, "  ]\n}}\n");
+			std::fclose(file);
+			return true;
+		}
+	};
+}
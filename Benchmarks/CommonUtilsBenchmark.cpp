@@ -0,0 +1,538 @@
+/// CommonUtils 所有基础工具的基准测试，结果可以写入 JSON 文件，由 Benchmarks/CompareBenchmarks.py 比较两次运行的结果
+#include "BenchmarkHarness.hpp"
+
+#include <Cango/CommonUtils/AsyncItemPool.hpp>
+#include <Cango/CommonUtils/CallRateCounterX.hpp>
+#include <Cango/CommonUtils/Configurations.hpp>
+#include <Cango/CommonUtils/CounterBank.hpp>
+#include <Cango/CommonUtils/CounterX.hpp>
+#include <Cango/CommonUtils/EventLoop.hpp>
+#include <Cango/CommonUtils/IntervalSleeper.hpp>
+#include <Cango/CommonUtils/ItemPoolCapture.hpp>
+#include <Cango/CommonUtils/MappedFileSink.hpp>
+#include <Cango/CommonUtils/MetricsRegistry.hpp>
+#include <Cango/CommonUtils/ObjectOwnership.hpp>
+#include <Cango/CommonUtils/ScopeNotifier.hpp>
+#include <Cango/CommonUtils/SharedItemPool.hpp>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/filesystem/operations.hpp>
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+	using namespace Cango;
+	using namespace Cango::Benchmarks;
+	using Clock = std::chrono::steady_clock;
+
+	struct PodItem {
+		std::uint64_t Sequence{};
+		std::int64_t Timestamp{};
+		std::array<std::uint8_t, 48> Payload{};
+	};
+
+	struct ObjectItem {
+		std::uint64_t Sequence{};
+		std::vector<float> Values = std::vector<float>(64);
+	};
+
+	std::int64_t NowNanoseconds() noexcept {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+	}
+
+	template <typename TItem>
+	void BenchmarkTripleItemPoolSingleThread(BenchmarkSuite& suite, const std::string_view name) {
+		TripleItemPool<TItem> pool{};
+		TItem input{};
+		TItem output{};
+		suite.MeasureNanoseconds(fmt::format("TripleItemPool/{}/SetItem", name), [&] {
+			++input.Sequence;
+			pool.SetItem(input);
+		});
+		suite.MeasureNanoseconds(fmt::format("TripleItemPool/{}/SetGetItem", name), [&] {
+			++input.Sequence;
+			pool.SetItem(input);
+			DoNotOptimize(pool.GetItem(output));
+		});
+	}
+
+	/// 一个写入线程和一个读取线程同时全速运行，统计两者的吞吐量
+	void BenchmarkTripleItemPoolMultiThread(BenchmarkSuite& suite) {
+		constexpr std::string_view name = "TripleItemPool/Pod/MultiThread";
+		if (!suite.IsEnabled(name)) return;
+
+		TripleItemPool<PodItem> pool{};
+		std::atomic_bool is_running{true};
+		std::uint64_t read_count = 0;
+
+		std::thread reader{[&] {
+			PodItem item{};
+			while (is_running.load(std::memory_order_relaxed)) if (pool.GetItem(item)) ++read_count;
+		}};
+
+		PodItem item{};
+		const auto begin = Clock::now();
+		const auto end = begin + suite.GetRunDuration();
+		while (Clock::now() < end) {
+			for (int index = 0; index < 256; ++index) {
+				++item.Sequence;
+				pool.SetItem(item);
+			}
+		}
+		const auto seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+		is_running = false;
+		reader.join();
+
+		suite.RecordThroughput(name, "writes_per_s", static_cast<double>(item.Sequence) / seconds, "op/s");
+		suite.RecordThroughput(name, "reads_per_s", static_cast<double>(read_count) / seconds, "op/s");
+	}
+
+	/// 写入者写入时间戳，读取者忙等新的物品并记录从写入到读取的延迟
+	void BenchmarkTripleItemPoolHandoff(BenchmarkSuite& suite) {
+		constexpr std::string_view name = "TripleItemPool/Pod/HandoffLatency";
+		if (!suite.IsEnabled(name)) return;
+
+		const std::size_t sample_count = suite.IsQuick() ? 2000 : 20000;
+		TripleItemPool<PodItem> pool{};
+		std::atomic_uint64_t received{0};
+		std::vector<double> samples{};
+		samples.reserve(sample_count);
+
+		std::thread reader{[&] {
+			PodItem item{};
+			while (samples.size() < sample_count) {
+				if (!pool.GetItem(item)) {
+					std::this_thread::yield();
+					continue;
+				}
+				samples.push_back(static_cast<double>(NowNanoseconds() - item.Timestamp));
+				received.store(item.Sequence, std::memory_order_release);
+			}
+		}};
+
+		PodItem item{};
+		for (std::size_t index = 0; index < sample_count; ++index) {
+			item.Sequence = index + 1;
+			item.Timestamp = NowNanoseconds();
+			pool.SetItem(item);
+			// 等待读取者取走后再写入，保证每个样本都是一次完整的交接
+			while (received.load(std::memory_order_acquire) != item.Sequence) std::this_thread::yield();
+		}
+		reader.join();
+
+		suite.RecordPercentiles(name, samples, "ns");
+	}
+
+	void BenchmarkCounters(BenchmarkSuite& suite) {
+		CallRateCounter counter{};
+		suite.MeasureNanoseconds("CallRateCounterX/32/Call", [&] { DoNotOptimize(counter.Call()); });
+
+		auto now = Clock::now();
+		CallRateCounter counter_with_time{};
+		suite.MeasureNanoseconds("CallRateCounterX/32/CallWithTime", [&] {
+			now += std::chrono::microseconds{10};
+			DoNotOptimize(counter_with_time.Call(now));
+		});
+
+		Counter32 simple{0, 1000};
+		suite.MeasureNanoseconds("CounterX/32/Count", [&] {
+			if (simple.Count()) simple.Reset();
+			DoNotOptimize(simple);
+		});
+	}
+
+	/// 统计每次休眠后的实际间隔与期望间隔的偏差
+	template <typename TDuration>
+	void BenchmarkIntervalSleeper(BenchmarkSuite& suite, const std::string_view name, const TDuration interval) {
+		if (!suite.IsEnabled(name)) return;
+
+		const auto tick_count = std::max<std::size_t>(
+			50, static_cast<std::size_t>(suite.GetRunDuration() / std::chrono::duration_cast<std::chrono::microseconds>(interval)));
+		IntervalSleeperX<TDuration, std::chrono::steady_clock> sleeper{interval};
+		std::vector<double> samples{};
+		samples.reserve(tick_count);
+
+		sleeper.Sleep();
+		auto last = Clock::now();
+		for (std::size_t index = 0; index < tick_count; ++index) {
+			sleeper.Sleep();
+			const auto now = Clock::now();
+			const auto actual = std::chrono::duration<double, std::micro>(now - last).count();
+			samples.push_back(std::abs(actual - std::chrono::duration<double, std::micro>(interval).count()));
+			last = now;
+		}
+
+		suite.RecordPercentiles(name, samples, "us");
+	}
+
+	struct OwnedObject {
+		std::uint64_t Value{};
+	};
+
+	void BenchmarkOwner(BenchmarkSuite& suite) {
+		suite.MeasureNanoseconds("Owner/Create", [] {
+			Owner<OwnedObject> owner{};
+			DoNotOptimize(owner);
+		});
+
+		const Owner<OwnedObject> owner{};
+		suite.MeasureNanoseconds("Owner/ToObjectUser", [&] {
+			const ObjectUser<OwnedObject> user = owner;
+			DoNotOptimize(user);
+		});
+
+		suite.MeasureNanoseconds("Owner/CredentialLock", [&] {
+			const Credential<OwnedObject> credential = owner;
+			const auto user = credential.lock();
+			DoNotOptimize(user);
+		});
+	}
+
+	/// 日志调用的开销，使用空输出以排除磁盘的影响
+	void BenchmarkLogging(BenchmarkSuite& suite) {
+		const auto logger = std::make_shared<spdlog::logger>("benchmark", std::make_shared<spdlog::sinks::null_sink_mt>());
+		logger->set_level(spdlog::level::info);
+
+		std::uint64_t sequence = 0;
+		suite.MeasureNanoseconds("Logger/Enabled", [&] { logger->info("Benchmark> 序号({}) 数值({})", ++sequence, 3.5); });
+		suite.MeasureNanoseconds("Logger/Disabled", [&] { logger->debug("Benchmark> 序号({}) 数值({})", ++sequence, 3.5); });
+
+		suite.MeasureNanoseconds("ScopeNotifier/Enabled", [&] {
+			const ScopeNotifier notifier{"Benchmark", logger, spdlog::level::info};
+		});
+		suite.MeasureNanoseconds("ScopeNotifier/Disabled", [&] {
+			const ScopeNotifier notifier{"Benchmark", logger, spdlog::level::debug};
+		});
+	}
+
+	/// 生成大约 1MB 的配置文件，统计读取的速度
+	void BenchmarkConfigurations(BenchmarkSuite& suite, const boost::filesystem::path& directory) {
+		const auto logger = std::make_shared<spdlog::logger>("configurations", std::make_shared<spdlog::sinks::null_sink_mt>());
+
+		VariableTable source{};
+		for (int section = 0; section < 256; ++section) {
+			for (int key = 0; key < 64; ++key) {
+				source.put(fmt::format("Section{}.Key{}", section, key), fmt::format("value_{}_{}_{}", section, key, section * key));
+			}
+		}
+
+		for (const std::string_view extension : {"json", "ini", "xml", "info"}) {
+			const auto name = fmt::format("Configurations/Load/{}", extension);
+			if (!suite.IsEnabled(name)) continue;
+
+			const auto file = directory / fmt::format("config.{}", extension);
+			if (!SaveVariableTableToFile(*logger, source, file)) continue;
+			const auto size = static_cast<double>(boost::filesystem::file_size(file));
+
+			std::size_t load_count = 0;
+			const auto begin = Clock::now();
+			const auto end = begin + suite.GetRunDuration();
+			do {
+				VariableTable table{};
+				if (!LoadVariableTableFromFile(*logger, table, file)) break;
+				++load_count;
+			}
+			while (Clock::now() < end);
+			const auto seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+			if (load_count > 0) suite.RecordThroughput(name, "throughput", size * static_cast<double>(load_count) / seconds / 1e6, "MB/s");
+		}
+	}
+
+	void BenchmarkSharedItemPoolSingleProcess(BenchmarkSuite& suite) {
+		constexpr std::string_view pool_name = "/cango_benchmark_pool";
+		constexpr std::string_view set_name = "SharedTripleItemPool/Pod/SetItem";
+		constexpr std::string_view set_get_name = "SharedTripleItemPool/Pod/SetGetItem";
+		if (!suite.IsEnabled(set_name) && !suite.IsEnabled(set_get_name)) return;
+
+		// 清理之前崩溃时遗留的共享内存
+		auto& logger = *spdlog::default_logger();
+		if (!SharedTripleByteBuffer::Remove(logger, pool_name)) return;
+		SharedTripleItemPool<PodItem> pool{};
+		if (!pool.Create(logger, pool_name)) return;
+
+		PodItem input{};
+		PodItem output{};
+		suite.MeasureNanoseconds(set_name, [&] {
+			++input.Sequence;
+			pool.SetItem(input);
+		});
+		suite.MeasureNanoseconds(set_get_name, [&] {
+			++input.Sequence;
+			pool.SetItem(input);
+			DoNotOptimize(pool.GetItem(output));
+		});
+	}
+
+	/// 子进程把收到的物品原样写回，记录两个进程之间通过共享内存往返一次的延迟
+	void BenchmarkSharedItemPoolRoundTrip(BenchmarkSuite& suite) {
+		constexpr std::string_view name = "SharedTripleItemPool/Pod/RoundTripLatency";
+		constexpr std::string_view ping_name = "/cango_benchmark_ping";
+		constexpr std::string_view pong_name = "/cango_benchmark_pong";
+		constexpr std::uint64_t stop_sequence = ~0ull;
+		if (!suite.IsEnabled(name)) return;
+
+		auto& logger = *spdlog::default_logger();
+		if (!SharedTripleByteBuffer::Remove(logger, ping_name) || !SharedTripleByteBuffer::Remove(logger, pong_name)) return;
+		SharedTripleItemPool<PodItem> ping{};
+		SharedTripleItemPool<PodItem> pong{};
+		if (!ping.Create(logger, ping_name) || !pong.Create(logger, pong_name)) return;
+
+		// 自旋等待时让出处理器，避免在核心数较少的机器上饿死对端进程
+		const auto wait = [](SharedTripleItemPool<PodItem>& pool, PodItem& item) { while (!pool.GetItem(item)) sched_yield(); };
+
+		const pid_t child = ::fork();
+		if (child == -1) return;
+		if (child == 0) {
+			SharedTripleItemPool<PodItem> child_ping{};
+			SharedTripleItemPool<PodItem> child_pong{};
+			if (!child_ping.Attach(ping_name) || !child_pong.Attach(pong_name)) std::_Exit(1);
+			PodItem item{};
+			do {
+				wait(child_ping, item);
+				child_pong.SetItem(item);
+			}
+			while (item.Sequence != stop_sequence);
+			std::_Exit(0);
+		}
+
+		const std::size_t sample_count = suite.IsQuick() ? 2000 : 20000;
+		std::vector<double> samples{};
+		samples.reserve(sample_count);
+		PodItem item{};
+		for (std::uint64_t sequence = 0; sequence < sample_count; ++sequence) {
+			const auto begin = NowNanoseconds();
+			item.Sequence = sequence;
+			ping.SetItem(item);
+			do wait(pong, item); while (item.Sequence != sequence);
+			samples.push_back(static_cast<double>(NowNanoseconds() - begin));
+		}
+		item.Sequence = stop_sequence;
+		ping.SetItem(item);
+		::waitpid(child, nullptr, 0);
+
+		suite.RecordPercentiles(name, samples, "ns");
+	}
+
+	/// 模拟看门狗的一帧：对所有计数器计数，再重置本帧观测到的目标，同时测量逐个调用 CounterX 的耗时作为对照
+	template <typename TNumber>
+	void BenchmarkCounterBank(BenchmarkSuite& suite, const std::string_view type, const std::size_t counterCount) {
+		std::mt19937 random{42};
+		std::uniform_int_distribution<int> max_distribution{1, 20};
+		std::bernoulli_distribution seen_distribution{0.7};
+
+		std::vector<CounterX<TNumber>> counters(counterCount);
+		CounterBank<TNumber> bank{counterCount};
+		for (std::size_t index = 0; index < counterCount; ++index) {
+			const auto max_count = static_cast<TNumber>(max_distribution(random));
+			counters[index].MaxCount = max_count;
+			bank.SetMaxCount(index, max_count);
+		}
+
+		std::vector<std::uint64_t> seen(bank.GetMaskWordCount());
+		for (std::size_t index = 0; index < counterCount; ++index)
+			if (seen_distribution(random)) seen[index / 64] |= std::uint64_t{1} << index % 64;
+		std::vector<std::uint64_t> reached(bank.GetMaskWordCount());
+
+		suite.MeasureNanoseconds(fmt::format("CounterX/{}/{}/Frame", type, counterCount), [&] {
+			std::ranges::fill(reached, 0);
+			for (std::size_t index = 0; index < counterCount; ++index)
+				if (counters[index].Count()) reached[index / 64] |= std::uint64_t{1} << index % 64;
+			CounterBank<TNumber>::ForEachSelected(seen, [&counters](const std::size_t index) { counters[index].Reset(); });
+			DoNotOptimize(reached);
+		});
+		suite.MeasureNanoseconds(fmt::format("CounterBank/{}/{}/Frame", type, counterCount), [&] {
+			DoNotOptimize(bank.CountAll(reached));
+			bank.ResetSelected(seen);
+		});
+	}
+
+	LoopTask Pinger(
+		CoroutineItemPool<std::uint64_t>& ping,
+		CoroutineItemPool<std::uint64_t>& pong,
+		EventLoop& loop,
+		const std::uint64_t count,
+		Clock::duration& duration) {
+		const auto begin = Clock::now();
+		for (std::uint64_t sequence = 0; sequence < count; ++sequence) {
+			ping.SetItem(sequence);
+			while (co_await pong.NextItem() != sequence) {}
+		}
+		duration = Clock::now() - begin;
+		loop.Stop();
+	}
+
+	LoopTask Ponger(CoroutineItemPool<std::uint64_t>& ping, CoroutineItemPool<std::uint64_t>& pong) {
+		while (true) pong.SetItem(co_await ping.NextItem());
+	}
+
+	/// 同一个事件循环中的两个协程通过物品池往返传递序号，记录每次往返的耗时
+	void BenchmarkEventLoopRoundTrip(BenchmarkSuite& suite) {
+		constexpr std::string_view name = "EventLoop/Coroutine/RoundTrip";
+		if (!suite.IsEnabled(name)) return;
+
+		EventLoop loop{};
+		CoroutineItemPool<std::uint64_t> ping{loop};
+		CoroutineItemPool<std::uint64_t> pong{loop};
+		if (!loop.Initialize() || !ping.Initialize() || !pong.Initialize()) return;
+
+		const std::uint64_t count = suite.IsQuick() ? 10000 : 100000;
+		Clock::duration duration{};
+		loop.Spawn(Ponger(ping, pong));
+		loop.Spawn(Pinger(ping, pong, loop, count, duration));
+		loop.Run();
+
+		suite.Record(std::string{name}, "ns_per_op", std::chrono::duration<double, std::nano>(duration).count() / static_cast<double>(count), "ns");
+	}
+
+	LoopTask PeriodicTask(EventLoop& loop, std::vector<double>& samples, const Clock::time_point end) {
+		constexpr std::chrono::milliseconds interval{1};
+		CoroutineIntervalSleeper sleeper{loop, interval};
+		co_await sleeper.NextTick();
+		auto last = Clock::now();
+		while (last < end) {
+			co_await sleeper.NextTick();
+			const auto now = Clock::now();
+			const auto actual = std::chrono::duration<double, std::micro>(now - last).count();
+			samples.push_back(std::abs(actual - std::chrono::duration<double, std::micro>(interval).count()));
+			last = now;
+		}
+	}
+
+	/// 同一个事件循环中运行 200 个 1ms 的周期任务，统计实际间隔与期望间隔的偏差
+	void BenchmarkEventLoopPeriodic(BenchmarkSuite& suite) {
+		constexpr std::string_view name = "EventLoop/Coroutine/PeriodicJitter";
+		constexpr std::size_t task_count = 200;
+		if (!suite.IsEnabled(name)) return;
+
+		EventLoop loop{};
+		if (!loop.Initialize()) return;
+		std::vector<double> samples{};
+		const auto end = Clock::now() + suite.GetRunDuration();
+		for (std::size_t index = 0; index < task_count; ++index) loop.Spawn(PeriodicTask(loop, samples, end));
+		loop.Run();
+
+		suite.RecordPercentiles(name, samples, "us");
+	}
+
+	void BenchmarkMetrics(BenchmarkSuite& suite) {
+		auto& registry = MetricsRegistry::Instance();
+		const auto counter = registry.RegisterCounter("benchmark_counter");
+		const auto rate = registry.RegisterRate("benchmark_rate");
+		const auto gauge = registry.RegisterGauge("benchmark_gauge");
+		const auto histogram = registry.RegisterHistogram("benchmark_latency_ns");
+
+		std::uint64_t value = 0;
+		suite.MeasureNanoseconds("MetricsRegistry/Counter/Add", [&] { counter.Add(); });
+		suite.MeasureNanoseconds("MetricsRegistry/Rate/Call", [&] { rate.Call(); });
+		suite.MeasureNanoseconds("MetricsRegistry/Gauge/Set", [&] { gauge.Set(static_cast<double>(++value)); });
+		suite.MeasureNanoseconds("MetricsRegistry/Histogram/Record", [&] { histogram.Record(++value & 0xffff); });
+
+		// 多个线程同时更新同一个指标，反映缓存行争用的开销
+		constexpr std::string_view contended_name = "MetricsRegistry/Counter/Add4Threads";
+		if (!suite.IsEnabled(contended_name)) return;
+		constexpr std::size_t thread_count = 4;
+		const std::size_t count = suite.IsQuick() ? 100000 : 2000000;
+		std::vector<std::thread> threads{};
+		const auto begin = Clock::now();
+		for (std::size_t thread = 0; thread < thread_count; ++thread)
+			threads.emplace_back([&counter, count] { for (std::size_t index = 0; index < count; ++index) counter.Add(); });
+		for (auto& thread : threads) thread.join();
+		const auto duration = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+		suite.Record(std::string{contended_name}, "ns_per_op", duration / static_cast<double>(count * thread_count), "ns");
+	}
+
+	/// 捕获对 SetItem GetItem 的额外开销，捕获文件是环形缓冲区，测量时间再长也不会变大
+	void BenchmarkItemPoolCapture(BenchmarkSuite& suite, const boost::filesystem::path& directory) {
+		PodItem input{};
+		PodItem output{};
+
+		CapturedTripleItemPool<PodItem> plain{};
+		suite.MeasureNanoseconds("ItemPoolCapture/Pod/SetGetItem", [&] {
+			++input.Sequence;
+			plain.SetItem(input);
+			DoNotOptimize(plain.GetItem(output));
+		});
+
+		constexpr std::string_view captured_name = "ItemPoolCapture/Pod/SetGetItemCaptured";
+		if (!suite.IsEnabled(captured_name)) return;
+		CapturedTripleItemPool<PodItem> captured{};
+		if (!captured.StartCapture(directory / "capture.bin", std::size_t{1} << 20)) return;
+		suite.MeasureNanoseconds(captured_name, [&] {
+			++input.Sequence;
+			captured.SetItem(input);
+			DoNotOptimize(captured.GetItem(output));
+		});
+		captured.StopCapture();
+	}
+
+	/// 使用与默认日志器相同的格式，对比内存映射日志与 spdlog 滚动文件每条日志的耗时
+	void BenchmarkFileSinks(BenchmarkSuite& suite, const boost::filesystem::path& directory) {
+		constexpr std::size_t segment_size = 5 * 1024 * 1024;
+		const auto measure = [&suite](const std::string_view name, std::shared_ptr<spdlog::sinks::sink> sink) {
+			spdlog::logger logger{"benchmark", std::move(sink)};
+			std::uint64_t sequence = 0;
+			suite.MeasureNanoseconds(name, [&] {
+				const auto index = ++sequence;
+				logger.info("Benchmark> 第 {} 条日志，附带一些典型的负载 {:.3f} {}", index, static_cast<double>(index) * 0.5, "detection");
+			});
+			logger.flush();
+		};
+
+		if (constexpr std::string_view name = "RotatingFileSink/Log"; suite.IsEnabled(name))
+			measure(name, std::make_shared<spdlog::sinks::rotating_file_sink_mt>((directory / "rotating.log").string(), segment_size, 2));
+
+		// 输出在离开作用域时关闭，等待后台线程处理完关闭的分段
+		if (constexpr std::string_view name = "MappedFileSink/Log"; suite.IsEnabled(name)) {
+			const auto sink = std::make_shared<MappedFileSinkMT>();
+			if (sink->Open({(directory / "mapped_").string(), segment_size, false})) measure(name, sink);
+		}
+	}
+}
+
+int main(const int argc, const char* const* argv) {
+	BenchmarkSuite suite{};
+	if (!suite.ParseArguments(argc, argv)) return 2;
+
+	BenchmarkTripleItemPoolSingleThread<PodItem>(suite, "Pod");
+	BenchmarkTripleItemPoolSingleThread<ObjectItem>(suite, "Object");
+	BenchmarkTripleItemPoolMultiThread(suite);
+	BenchmarkTripleItemPoolHandoff(suite);
+	BenchmarkCounters(suite);
+	BenchmarkIntervalSleeper(suite, "IntervalSleeperX/1ms/Jitter", std::chrono::milliseconds{1});
+	BenchmarkIntervalSleeper(suite, "IntervalSleeperX/10ms/Jitter", std::chrono::milliseconds{10});
+	BenchmarkOwner(suite);
+	BenchmarkLogging(suite);
+
+	// 需要写入文件的测试共用一个临时目录，结束后删除
+	const auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("cango-benchmark-%%%%%%");
+	boost::filesystem::create_directories(directory);
+	BenchmarkConfigurations(suite, directory);
+	BenchmarkSharedItemPoolSingleProcess(suite);
+	BenchmarkSharedItemPoolRoundTrip(suite);
+	for (const std::size_t count : {1000, 10000}) {
+		BenchmarkCounterBank<std::uint8_t>(suite, "u8", count);
+		BenchmarkCounterBank<std::uint16_t>(suite, "u16", count);
+		BenchmarkCounterBank<std::uint32_t>(suite, "u32", count);
+		BenchmarkCounterBank<std::uint64_t>(suite, "u64", count);
+		BenchmarkCounterBank<std::int32_t>(suite, "i32", count);
+	}
+	BenchmarkEventLoopRoundTrip(suite);
+	BenchmarkEventLoopPeriodic(suite);
+	BenchmarkMetrics(suite);
+	BenchmarkItemPoolCapture(suite, directory);
+	BenchmarkFileSinks(suite, directory);
+
+	boost::system::error_code error{};
+	boost::filesystem::remove_all(directory, error);
+
+	return suite.WriteJson() ? 0 : 1;
+}
@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""比较两次 CommonUtils 基准测试的 JSON 结果，变差超过阈值的项目视为性能回退。
+
+用法：CompareBenchmarks.py baseline.json current.json [--threshold 0.10]
+存在性能回退时返回 1 ，便于在持续集成中使用。
+"""
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    with open(path, encoding="utf-8") as file:
+        document = json.load(file)
+    return {(item["name"], item["metric"]): item for item in document["results"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="比较两次基准测试的结果")
+    parser.add_argument("baseline", help="作为基准的结果文件")
+    parser.add_argument("current", help="本次运行的结果文件")
+    parser.add_argument("--threshold", type=float, default=0.10, help="允许变差的比例，默认为 0.10")
+    arguments = parser.parse_args()
+
+    baseline = load_results(arguments.baseline)
+    current = load_results(arguments.current)
+
+    regressions = 0
+    print(f"{'名称':<52} {'指标':<14} {'基准':>14} {'本次':>14} {'变化':>9}")
+    for key in sorted(baseline.keys() & current.keys()):
+        before = baseline[key]["value"]
+        after = current[key]["value"]
+        if before is None or after is None or before == 0:
+            continue
+
+        change = (after - before) / before
+        # 统一成“变差的比例”，耗时变大或者吞吐量变小都是正数
+        worse = change if current[key]["better"] == "lower" else -change
+        status = ""
+        if worse > arguments.threshold:
+            status = "回退"
+            regressions += 1
+        elif worse < -arguments.threshold:
+            status = "改进"
+
+        name, metric = key
+        print(f"{name:<52} {metric:<14} {before:>14.2f} {after:>14.2f} {change:>+8.1%} {status}")
+
+    for name, metric in sorted(baseline.keys() - current.keys()):
+        print(f"{name:<52} {metric:<14} 本次结果中缺失")
+    for name, metric in sorted(current.keys() - baseline.keys()):
+        print(f"{name:<52} {metric:<14} 新增")
+
+    print(f"共 {regressions} 项性能回退（阈值 {arguments.threshold:.0%}）")
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -3,9 +3,15 @@
 #include <Cango/CommonUtils/AsyncItemPool.hpp>
 #include <Cango/CommonUtils/CallRateCounterX.hpp>
 #include <Cango/CommonUtils/Configurations.hpp>
+#include <Cango/CommonUtils/CounterBank.hpp>
 #include <Cango/CommonUtils/CounterX.hpp>
+#include <Cango/CommonUtils/EventLoop.hpp>
 #include <Cango/CommonUtils/GlobalLogger.hpp>
 #include <Cango/CommonUtils/IntervalSleeper.hpp>
+#include <Cango/CommonUtils/ItemPoolCapture.hpp>
 #include <Cango/CommonUtils/JoinThreads.hpp>
+#include <Cango/CommonUtils/MappedFileSink.hpp>
+#include <Cango/CommonUtils/MetricsRegistry.hpp>
 #include <Cango/CommonUtils/ObjectOwnership.hpp>
 #include <Cango/CommonUtils/ScopeNotifier.hpp>
+#include <Cango/CommonUtils/SharedItemPool.hpp>
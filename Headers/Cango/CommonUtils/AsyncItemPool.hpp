@@ -4,7 +4,10 @@
 #include <atomic>
 #include <concepts>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 #ifdef CANGO_COMMON_UTILS_ENABLE_SCOPE_NOTIFIER_FOR_AsyncItemPool
 #include "ScopeNotifier.hpp"
@@ -14,6 +17,128 @@
 #define CANGO_TRIPLE_ITEM_POOL_ENABLE_LOG_LIFETIME
 #endif
 
+namespace Cango::InternalDetails {
+	/// @brief 三重缓冲区的槽位协议，负责在一个写入者和一个读取者之间分配槽位，不关心槽位中存储的内容。
+	///	@details
+	///		每个槽位的状态字中，低 8 位为状态，高位为占用者的标记（进程内为零，跨进程时为进程号）。
+	///		写入者先丢弃其他已写入的槽位再发布新的槽位，所以任何时刻最多只有一个已写入的槽位，
+	///		读取者不会在读到新物品之后再读到旧物品。
+	///		进程内的 @c TripleBufferSlots 和跨进程的 @c SharedTripleByteBuffer 共用这套协议。
+	struct TripleBufferSlotProtocol {
+		static constexpr std::uint8_t ItemCount = 3;
+		static constexpr std::uint64_t StatusMask = 0xff;
+
+		enum Status : std::uint8_t {
+			Empty = 0,
+			Full = 1,
+			Busy = 2
+		};
+
+		/// @brief 占用一个没有被读取者占用的槽位用于写入，返回槽位的序号
+		///	@param busy 占用槽位时写入的状态字
+		///	@param onFullRound 每检查完一轮所有槽位都没有成功时调用
+		template <typename TStatus, typename TIndex>
+		[[nodiscard]] static std::uint32_t AcquireWrite(
+			const std::atomic<TIndex>& writerIndex,
+			std::atomic<TStatus>* statusList,
+			const TStatus busy,
+			auto&& onFullRound) noexcept {
+			std::uint32_t index = writerIndex.load(std::memory_order_relaxed);
+			for (std::size_t attempt = 1;; ++attempt) {
+				index = (index + 1) % ItemCount;
+				auto status = statusList[index].load(std::memory_order_relaxed);
+				if ((status & StatusMask) != Busy && statusList[index].compare_exchange_strong(
+					status, busy, std::memory_order_acquire, std::memory_order_relaxed))
+					return index;
+				if (attempt % ItemCount == 0) onFullRound();
+			}
+		}
+
+		/// @brief 发布写入完成的槽位
+		///	@details
+		///		必须先丢弃其他较旧的物品，再发布新的物品。
+		///		如果先发布，读取者可能在读走新物品之后，又在丢弃之前读走较旧的物品。
+		template <typename TStatus, typename TIndex>
+		static void PublishWrite(
+			std::atomic<TIndex>& writerIndex,
+			std::atomic<TStatus>* statusList,
+			const std::uint32_t index) noexcept {
+			for (std::uint32_t other = 0; other < ItemCount; ++other) {
+				if (other == index) continue;
+				TStatus full = Full;
+				statusList[other].compare_exchange_strong(full, Empty, std::memory_order_relaxed);
+			}
+			statusList[index].store(Full, std::memory_order_release);
+			writerIndex.store(static_cast<TIndex>(index), std::memory_order_release);
+		}
+
+		/// @brief 占用已写入的槽位用于读取，在没有找到任何准备好的槽位时，操作将会失败
+		template <typename TStatus, typename TIndex>
+		[[nodiscard]] static bool AcquireRead(
+			const std::atomic<TIndex>& writerIndex,
+			std::atomic<TStatus>* statusList,
+			const TStatus busy,
+			std::uint32_t& index) noexcept {
+			const std::uint32_t latest = writerIndex.load(std::memory_order_acquire);
+			for (std::uint32_t offset = 0; offset < ItemCount; ++offset) {
+				index = (latest + ItemCount - offset) % ItemCount;
+				if (TStatus full = Full; statusList[index].compare_exchange_strong(
+					full, busy, std::memory_order_acquire, std::memory_order_relaxed))
+					return true;
+			}
+			return false;
+		}
+
+		/// @brief 释放读取完成的槽位
+		template <typename TStatus>
+		static void ReleaseRead(std::atomic<TStatus>* statusList, const std::uint32_t index) noexcept {
+			statusList[index].store(Empty, std::memory_order_release);
+		}
+	};
+
+	/// @brief 进程内的三重缓冲区槽位状态
+	class TripleBufferSlots {
+		using Protocol = TripleBufferSlotProtocol;
+
+	public:
+		static constexpr std::uint8_t ItemCount = Protocol::ItemCount;
+
+	private:
+		std::atomic_uint8_t WriterIndex{0};
+		std::array<std::atomic_uint8_t, ItemCount> StatusList{};
+
+	public:
+		/// @brief 占用一个没有被读取者占用的槽位用于写入，返回槽位的序号
+		[[nodiscard]] std::uint8_t AcquireWrite() noexcept {
+			// 只有一个读取者时，三个槽位中总有一个可以写入
+			constexpr std::uint8_t busy = Protocol::Busy;
+			return static_cast<std::uint8_t>(Protocol::AcquireWrite(WriterIndex, StatusList.data(), busy, [] {}));
+		}
+
+		/// @brief 发布写入完成的槽位，并丢弃其他较旧的物品
+		void PublishWrite(const std::uint8_t index) noexcept {
+			Protocol::PublishWrite(WriterIndex, StatusList.data(), index);
+		}
+
+		/// @brief 放弃正在写入的槽位，用于写入过程中抛出异常的情况，槽位中的内容被视为无效
+		void AbandonWrite(const std::uint8_t index) noexcept {
+			StatusList[index].store(Protocol::Empty, std::memory_order_release);
+		}
+
+		/// @brief 占用最新的已写入槽位用于读取，在没有找到任何准备好的槽位时，操作将会失败
+		[[nodiscard]] bool AcquireRead(std::uint8_t& index) noexcept {
+			constexpr std::uint8_t busy = Protocol::Busy;
+			std::uint32_t acquired = 0;
+			if (!Protocol::AcquireRead(WriterIndex, StatusList.data(), busy, acquired)) return false;
+			index = static_cast<std::uint8_t>(acquired);
+			return true;
+		}
+
+		/// @brief 释放读取完成的槽位
+		void ReleaseRead(const std::uint8_t index) noexcept { Protocol::ReleaseRead(StatusList.data(), index); }
+	};
+}
+
 namespace Cango :: inline CommonUtils {
 	/// @brief 三重字节缓冲区，用于在两个线程中无阻塞地存取较新的数据。
 	/// @details
@@ -23,45 +148,93 @@ namespace Cango :: inline CommonUtils {
 	class NonblockTripleByteBuffer {
 	public:
 		static constexpr auto ItemSize = TSingleItemSize;
-		static constexpr auto ItemCount = 3;
+		static constexpr auto ItemCount = InternalDetails::TripleBufferSlots::ItemCount;
 
 	private:
-		enum Status : std::uint8_t {
-			Empty = 0,
-			Full = 1,
-			Busy = 2
-		};
-
-		std::atomic_uint8_t WriterIndex{0};
+		InternalDetails::TripleBufferSlots Slots{};
 
 		/// @brief 三个缓冲区，用于存储物品的字节
 		std::array<std::array<std::uint8_t, ItemSize>, ItemCount> Buffer{};
-		std::array<std::atomic_uint8_t, ItemCount> StatusList{};
 
 	public:
 		void WriteBytes(const void* data) noexcept {
-			std::uint8_t index{WriterIndex};
-			std::uint8_t busy;
-			do {
-				busy = Busy;
-				index = (index + 1) % 3;
-			}
-			while (StatusList[index].compare_exchange_weak(busy, Busy));
+			const auto index = Slots.AcquireWrite();
 			std::memcpy(Buffer[index].data(), data, ItemSize);
-			StatusList[index] = Full;
-			WriterIndex = index;
+			Slots.PublishWrite(index);
 		}
 
 		[[nodiscard]] bool ReadBytes(void* data) noexcept {
-			for (std::uint8_t index = 0; index < 3; ++index) {
-				if (std::uint8_t full = Full;
-					!StatusList[index].compare_exchange_weak(full, Busy))
-					continue;
-				std::memcpy(data, Buffer[index].data(), ItemSize);
-				StatusList[index] = Empty;
-				return true;
+			std::uint8_t index;
+			if (!Slots.AcquireRead(index)) return false;
+			std::memcpy(data, Buffer[index].data(), ItemSize);
+			Slots.ReleaseRead(index);
+			return true;
+		}
+	};
+
+	/// @brief 三重对象缓冲区，用于在两个线程中无阻塞地存取较新的数据。
+	///	@details
+	///		槽位中存放真正的 @c TItem 对象，通过赋值或交换存取，适用于持有堆内存的物品（例如包含 std::vector 的结构体）。
+	///		使用交换存取时，物品内部的堆缓冲区会在写入者、数据池、读取者之间循环复用，稳定运行后不再分配内存。
+	///		赋值或交换抛出异常时，槽位被释放并且其中的物品被丢弃，异常继续传递给调用者。
+	template <std::default_initializable TItem>
+	class NonblockTripleObjectBuffer {
+	public:
+		static constexpr auto ItemCount = InternalDetails::TripleBufferSlots::ItemCount;
+
+		static constexpr bool IsNothrowCopy = std::is_nothrow_copy_assignable_v<TItem>;
+		static constexpr bool IsNothrowSwap = std::is_nothrow_swappable_v<TItem>;
+
+	private:
+		InternalDetails::TripleBufferSlots Slots{};
+		std::array<TItem, ItemCount> Items{};
+
+		/// @brief 在占用的写入槽位上执行操作，操作抛出异常时放弃槽位
+		template <bool TIsNothrow>
+		void Write(auto&& operation) noexcept(TIsNothrow) {
+			const auto index = Slots.AcquireWrite();
+			if constexpr (TIsNothrow) operation(Items[index]);
+			else {
+				try { operation(Items[index]); }
+				catch (...) {
+					Slots.AbandonWrite(index);
+					throw;
+				}
 			}
-			return false;
+			Slots.PublishWrite(index);
+		}
+
+	public:
+		/// @brief 复制写入物品，槽位中的对象通过赋值复用已有的容量
+		void WriteItem(const TItem& item) noexcept(IsNothrowCopy) {
+			Write<IsNothrowCopy>([&item](TItem& slot) { slot = item; });
+		}
+
+		/// @brief 交换写入物品，调用后 @c item 持有槽位中较旧的对象，可以清空后继续填充
+		void ExchangeWrite(TItem& item) noexcept(IsNothrowSwap) {
+			Write<IsNothrowSwap>([&item](TItem& slot) {
+				using std::swap;
+				swap(slot, item);
+			});
+		}
+
+		/// @brief 交换读取物品，调用前 @c item 持有的对象会留在槽位中，供写入者之后复用
+		[[nodiscard]] bool ExchangeRead(TItem& item) noexcept(IsNothrowSwap) {
+			std::uint8_t index;
+			if (!Slots.AcquireRead(index)) return false;
+
+			using std::swap;
+			if constexpr (IsNothrowSwap) swap(Items[index], item);
+			else {
+				// 交换失败时同样释放槽位，否则写入者只剩下两个槽位可用
+				try { swap(Items[index], item); }
+				catch (...) {
+					Slots.ReleaseRead(index);
+					throw;
+				}
+			}
+			Slots.ReleaseRead(index);
+			return true;
 		}
 	};
 
@@ -70,23 +243,57 @@ namespace Cango :: inline CommonUtils {
 	///		缓冲池的工作时涉及到三个角色：读取者，写入者，数据池。
 	///		读取者从数据池取出物品，写入者向数据池放入物品。
 	///		二者调用的函数分别为 @c GetItem @c SetItem 。
+	///		可平凡复制的物品以字节的形式存储在 @c NonblockTripleByteBuffer 中，
+	///		其他物品以对象的形式存储在 @c NonblockTripleObjectBuffer 中，通过交换复用物品内部的堆内存。
 	///	@tparam TItem 数据池中存储的物品的类型，要求支持默认构造和等号赋值。
 	template <std::default_initializable TItem>
 	class TripleItemPool final
 	{
-		NonblockTripleByteBuffer<sizeof(TItem)> Buffer{};
-
 	public:
 		using ItemType = TItem;
 
+		/// @brief 是否以字节的形式存储物品
+		static constexpr bool IsBytePath = std::is_trivially_copyable_v<TItem>;
+
+		/// @brief 复制写入是否不会抛出异常，对象存储时取决于物品的赋值运算符
+		static constexpr bool IsNothrowCopy = IsBytePath || std::is_nothrow_copy_assignable_v<TItem>;
+
+		/// @brief 交换存取是否不会抛出异常，对象存储时取决于物品的 swap
+		static constexpr bool IsNothrowSwap = IsBytePath || std::is_nothrow_swappable_v<TItem>;
+
+	private:
+		std::conditional_t<IsBytePath,
+			NonblockTripleByteBuffer<sizeof(TItem)>,
+			NonblockTripleObjectBuffer<TItem>> Buffer{};
+
+	public:
 		/// @brief 向数据池中写入数据，不阻塞当前线程
-		void SetItem(const TItem& item) noexcept {
-			Buffer.WriteBytes(&item);
+		///	@details 对象存储时复制可能分配内存并抛出异常，此时本次写入被丢弃，数据池仍然可用。
+		void SetItem(const TItem& item) noexcept(IsNothrowCopy) {
+			if constexpr (IsBytePath) Buffer.WriteBytes(&item);
+			else Buffer.WriteItem(item);
+		}
+
+		/// @brief 向数据池中移动写入数据，不阻塞当前线程。调用后 @c item 处于有效但未指定的状态
+		void SetItem(TItem&& item) noexcept(IsNothrowSwap) {
+			if constexpr (IsBytePath) Buffer.WriteBytes(&item);
+			else Buffer.ExchangeWrite(item);
+		}
+
+		/// @brief 向数据池中交换写入数据，不阻塞当前线程
+		///	@details
+		///		调用后 @c item 持有数据池中较旧的物品，其内部的堆内存可以被写入者复用，
+		///		写入者应当清空后重新填充它，而不是重新构造物品。
+		void ExchangeItem(TItem& item) noexcept(IsNothrowSwap) {
+			if constexpr (IsBytePath) Buffer.WriteBytes(&item);
+			else Buffer.ExchangeWrite(item);
 		}
 
 		/// @brief 从数据池中获取数据，不阻塞当前线程。在没有找到任何准备好的物品时，操作将会失败
-		[[nodiscard]] bool GetItem(TItem& item) noexcept {
-			return Buffer.ReadBytes(&item);
+		///	@details 对于非字节存储的物品，调用前 @c item 持有的对象会被交还给数据池，供写入者复用。
+		[[nodiscard]] bool GetItem(TItem& item) noexcept(IsNothrowSwap) {
+			if constexpr (IsBytePath) return Buffer.ReadBytes(&item);
+			else return Buffer.ExchangeRead(item);
 		}
 	};
 
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace Cango::InternalDetails {
+	/// @brief 计数器组使用的向量指令，没有对应指令集或者类型不受支持时 @c IsSupported 为 @c false
+	///	@details
+	///		x86-64 默认的 SSE2 即可支持无符号 8/16/32 位和有符号 32 位计数器，缺少的 min 指令由比较和选择代替；
+	///		SSE4.1 和 AVX2 提供对应的 min 指令，由 CMake 选项 Cango_CommonUtils_EnableSSE41 和 Cango_CommonUtils_EnableAVX2 开启。
+	template <typename TNumber>
+	struct CounterBankLanes {
+		static constexpr bool IsSupported = false;
+	};
+
+#if defined(__AVX2__)
+	struct CounterBankRegister {
+		using Type = __m256i;
+		static constexpr std::size_t Bytes = 32;
+
+		static Type Load(const void* data) noexcept { return _mm256_loadu_si256(static_cast<const Type*>(data)); }
+		static void Store(void* data, const Type value) noexcept { _mm256_storeu_si256(static_cast<Type*>(data), value); }
+		static Type Not(const Type value) noexcept { return _mm256_xor_si256(value, _mm256_set1_epi8(-1)); }
+	};
+
+	template <>
+	struct CounterBankLanes<std::uint8_t> : CounterBankRegister {
+		static constexpr bool IsSupported = true;
+		static Type Min(const Type a, const Type b) noexcept { return _mm256_min_epu8(a, b); }
+		static Type Equal(const Type a, const Type b) noexcept { return _mm256_cmpeq_epi8(a, b); }
+		static Type Sub(const Type a, const Type b) noexcept { return _mm256_sub_epi8(a, b); }
+		static std::uint64_t Mask(const Type value) noexcept { return static_cast<std::uint32_t>(_mm256_movemask_epi8(value)); }
+	};
+
+	template <>
+	struct CounterBankLanes<std::uint16_t> : CounterBankRegister {
+		static constexpr bool IsSupported = true;
+		static Type Min(const Type a, const Type b) noexcept { return _mm256_min_epu16(a, b); }
+		static Type Equal(const Type a, const Type b) noexcept { return _mm256_cmpeq_epi16(a, b); }
+		static Type Sub(const Type a, const Type b) noexcept { return _mm256_sub_epi16(a, b); }
+
+		static std::uint64_t Mask(const Type value) noexcept {
+			// 先压缩为字节，packs 在两个 128 位通道内分别交错，需要重排回原来的顺序
+			const auto packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(value, _mm256_setzero_si256()), 0b11'01'10'00);
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(packed)) & 0xffff;
+		}
+	};
+
+	template <>
+	struct CounterBankLanes<std::uint32_t> : CounterBankRegister {
+		static constexpr bool IsSupported = true;
+		static Type Min(const Type a, const Type b) noexcept { return _mm256_min_epu32(a, b); }
+		static Type Equal(const Type a, const Type b) noexcept { return _mm256_cmpeq_epi32(a, b); }
+		static Type Sub(const Type a, const Type b) noexcept { return _mm256_sub_epi32(a, b); }
+		static std::uint64_t Mask(const Type value) noexcept { return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(value))); }
+	};
+
+	template <>
+	struct CounterBankLanes<std::int32_t> : CounterBankLanes<std::uint32_t> {
+		static Type Min(const Type a, const Type b) noexcept { return _mm256_min_epi32(a, b); }
+	};
+#elif defined(__SSE2__)
+	struct CounterBankRegister {
+		using Type = __m128i;
+		static constexpr std::size_t Bytes = 16;
+
+		static Type Load(const void* data) noexcept { return _mm_loadu_si128(static_cast<const Type*>(data)); }
+		static void Store(void* data, const Type value) noexcept { _mm_storeu_si128(static_cast<Type*>(data), value); }
+		static Type Not(const Type value) noexcept { return _mm_xor_si128(value, _mm_set1_epi8(-1)); }
+	};
+
+	template <>
+	struct CounterBankLanes<std::uint8_t> : CounterBankRegister {
+		static constexpr bool IsSupported = true;
+		static Type Min(const Type a, const Type b) noexcept { return _mm_min_epu8(a, b); }
+		static Type Equal(const Type a, const Type b) noexcept { return _mm_cmpeq_epi8(a, b); }
+		static Type Sub(const Type a, const Type b) noexcept { return _mm_sub_epi8(a, b); }
+		static std::uint64_t Mask(const Type value) noexcept { return static_cast<std::uint32_t>(_mm_movemask_epi8(value)); }
+	};
+
+	template <>
+	struct CounterBankLanes<std::uint16_t> : CounterBankRegister {
+		static constexpr bool IsSupported = true;
+#if defined(__SSE4_1__)
+		static Type Min(const Type a, const Type b) noexcept { return _mm_min_epu16(a, b); }
+#else
+		// SSE2 没有无符号 16 位的 min ， a - max(a - b, 0) 即为 min(a, b)
+		static Type Min(const Type a, const Type b) noexcept { return _mm_sub_epi16(a, _mm_subs_epu16(a, b)); }
+#endif
+		static Type Equal(const Type a, const Type b) noexcept { return _mm_cmpeq_epi16(a, b); }
+		static Type Sub(const Type a, const Type b) noexcept { return _mm_sub_epi16(a, b); }
+
+		static std::uint64_t Mask(const Type value) noexcept {
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(value, _mm_setzero_si128()))) & 0xff;
+		}
+	};
+
+	template <>
+	struct CounterBankLanes<std::uint32_t> : CounterBankRegister {
+		static constexpr bool IsSupported = true;
+#if defined(__SSE4_1__)
+		static Type Min(const Type a, const Type b) noexcept { return _mm_min_epu32(a, b); }
+#else
+		// SSE2 只有有符号的 32 位比较，翻转符号位后有符号的大小关系与无符号的一致
+		static Type Min(const Type a, const Type b) noexcept {
+			const auto sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+			return Select(_mm_cmpgt_epi32(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign)), b, a);
+		}
+#endif
+		static Type Equal(const Type a, const Type b) noexcept { return _mm_cmpeq_epi32(a, b); }
+		static Type Sub(const Type a, const Type b) noexcept { return _mm_sub_epi32(a, b); }
+		static std::uint64_t Mask(const Type value) noexcept { return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(value))); }
+
+	protected:
+		/// @brief 掩码为全 1 的通道取 @c ifTrue ，其余通道取 @c ifFalse
+		static Type Select(const Type mask, const Type ifTrue, const Type ifFalse) noexcept {
+			return _mm_or_si128(_mm_and_si128(mask, ifTrue), _mm_andnot_si128(mask, ifFalse));
+		}
+	};
+
+	template <>
+	struct CounterBankLanes<std::int32_t> : CounterBankLanes<std::uint32_t> {
+#if defined(__SSE4_1__)
+		static Type Min(const Type a, const Type b) noexcept { return _mm_min_epi32(a, b); }
+#else
+		static Type Min(const Type a, const Type b) noexcept { return Select(_mm_cmpgt_epi32(a, b), b, a); }
+#endif
+	};
+#endif
+}
+
+namespace Cango :: inline CommonUtils {
+	/// @brief 整型计数器组，以结构体数组的形式批量计数、重置、检查大量计数器，语义与 @c CounterX 一致。
+	///	@details
+	///		在 x86-64 上，无符号 8/16/32 位和有符号 32 位计数器使用向量指令，每次处理一个寄存器宽度的计数器：
+	///		默认的 SSE2 为 128 位，启用 AVX2 后为 256 位，SSE4.1 只是提供更短的 min 指令序列。
+	///		其他类型、其他平台以及不足 64 个的尾部使用标量实现。
+	///		批量操作的结果以位掩码的形式返回，第 i 个计数器对应第 i / 64 个字的第 i % 64 位。
+	///	@note
+	///		与 @c CounterX 唯一的区别是最大值为 0 的无符号计数器：这里始终视为已到达，计数不会再增加。
+	template <std::integral TNumber>
+	class CounterBank final {
+	public:
+		using NumberType = TNumber;
+		using MaskWord = std::uint64_t;
+		static constexpr std::size_t MaskWordBits = 64;
+
+	private:
+		using Lanes = InternalDetails::CounterBankLanes<TNumber>;
+
+		std::vector<TNumber> CurrentList{};
+		std::vector<TNumber> MaxCountList{};
+
+		/// @brief 与 @c CounterX::Count 等价的无分支标量实现
+		static bool CountOne(TNumber& current, const TNumber maxCount) noexcept {
+			const TNumber clamped = std::min(current, maxCount);
+			current = static_cast<TNumber>(clamped + (clamped != maxCount));
+			return current == maxCount;
+		}
+
+		/// @brief 对从 begin 开始的 64 个计数器计数，返回到达最大值的掩码
+		MaskWord CountBlock(const std::size_t begin) noexcept {
+			MaskWord mask = 0;
+			if constexpr (Lanes::IsSupported) {
+				constexpr auto lane_count = Lanes::Bytes / sizeof(TNumber);
+				for (std::size_t offset = 0; offset < MaskWordBits; offset += lane_count) {
+					const auto current = Lanes::Load(CurrentList.data() + begin + offset);
+					const auto max_count = Lanes::Load(MaxCountList.data() + begin + offset);
+					const auto clamped = Lanes::Min(current, max_count);
+					// 未到达最大值的通道减去 -1 ，即加一
+					const auto next = Lanes::Sub(clamped, Lanes::Not(Lanes::Equal(clamped, max_count)));
+					Lanes::Store(CurrentList.data() + begin + offset, next);
+					mask |= Lanes::Mask(Lanes::Equal(next, max_count)) << offset;
+				}
+			}
+			else {
+				for (std::size_t offset = 0; offset < MaskWordBits; ++offset)
+					mask |= static_cast<MaskWord>(CountOne(CurrentList[begin + offset], MaxCountList[begin + offset])) << offset;
+			}
+			return mask;
+		}
+
+		/// @brief 检查从 begin 开始的 64 个计数器，返回已经到达最大值的掩码
+		MaskWord CheckBlock(const std::size_t begin) const noexcept {
+			MaskWord mask = 0;
+			if constexpr (Lanes::IsSupported) {
+				constexpr auto lane_count = Lanes::Bytes / sizeof(TNumber);
+				for (std::size_t offset = 0; offset < MaskWordBits; offset += lane_count) {
+					const auto current = Lanes::Load(CurrentList.data() + begin + offset);
+					const auto max_count = Lanes::Load(MaxCountList.data() + begin + offset);
+					mask |= Lanes::Mask(Lanes::Equal(Lanes::Min(current, max_count), max_count)) << offset;
+				}
+			}
+			else {
+				for (std::size_t offset = 0; offset < MaskWordBits; ++offset)
+					mask |= static_cast<MaskWord>(CurrentList[begin + offset] >= MaxCountList[begin + offset]) << offset;
+			}
+			return mask;
+		}
+
+		/// @brief 按照 64 个计数器一组处理，尾部不足一组的计数器逐个处理
+		std::size_t ForEachBlock(const std::span<MaskWord> result, auto&& block, auto&& single) const noexcept {
+			const auto size = CurrentList.size();
+			const auto full_block_count = size / MaskWordBits;
+			std::size_t total = 0;
+			for (std::size_t word = 0; word < full_block_count; ++word) {
+				result[word] = block(word * MaskWordBits);
+				total += static_cast<std::size_t>(std::popcount(result[word]));
+			}
+			if (const auto begin = full_block_count * MaskWordBits; begin < size) {
+				MaskWord mask = 0;
+				for (auto index = begin; index < size; ++index)
+					mask |= static_cast<MaskWord>(single(index)) << (index - begin);
+				result[full_block_count] = mask;
+				total += static_cast<std::size_t>(std::popcount(mask));
+			}
+			return total;
+		}
+
+	public:
+		CounterBank() noexcept = default;
+
+		/// @brief 创建给定数量的计数器，所有计数器使用相同的最大值
+		explicit CounterBank(const std::size_t count, const TNumber maxCount = {}) :
+			CurrentList(count), MaxCountList(count, maxCount) {}
+
+		/// @brief 调整计数器的数量，新增的计数器从 0 开始，使用给定的最大值
+		void Resize(const std::size_t count, const TNumber maxCount = {}) {
+			CurrentList.resize(count);
+			MaxCountList.resize(count, maxCount);
+		}
+
+		[[nodiscard]] std::size_t GetCount() const noexcept { return CurrentList.size(); }
+
+		/// @brief 保存所有计数器的掩码需要的字数
+		[[nodiscard]] std::size_t GetMaskWordCount() const noexcept {
+			return (CurrentList.size() + MaskWordBits - 1) / MaskWordBits;
+		}
+
+		[[nodiscard]] TNumber GetCurrent(const std::size_t index) const noexcept { return CurrentList[index]; }
+
+		[[nodiscard]] TNumber GetMaxCount(const std::size_t index) const noexcept { return MaxCountList[index]; }
+
+		void SetMaxCount(const std::size_t index, const TNumber maxCount) noexcept { MaxCountList[index] = maxCount; }
+
+		/// @brief 对单个计数器计数，与 @c CounterX::Count 相同
+		[[nodiscard]] bool Count(const std::size_t index) noexcept { return CountOne(CurrentList[index], MaxCountList[index]); }
+
+		/// @brief 检查单个计数器是否到达了最大值，与 @c CounterX::IsReached 相同
+		[[nodiscard]] bool IsReached(const std::size_t index) const noexcept { return CurrentList[index] >= MaxCountList[index]; }
+
+		void Reset(const std::size_t index) noexcept { CurrentList[index] = 0; }
+
+		/// @brief 对所有计数器计数
+		///	@param reached 至少 @c GetMaskWordCount() 个字，写入本次计数后到达最大值的计数器
+		///	@return 到达最大值的计数器数量
+		std::size_t CountAll(const std::span<MaskWord> reached) noexcept {
+			return ForEachBlock(reached, [this](const std::size_t begin) noexcept { return CountBlock(begin); },
+				[this](const std::size_t index) noexcept { return Count(index); });
+		}
+
+		/// @brief 检查所有计数器是否到达了最大值
+		///	@param reached 至少 @c GetMaskWordCount() 个字，写入已经到达最大值的计数器
+		///	@return 到达最大值的计数器数量
+		std::size_t CheckAll(const std::span<MaskWord> reached) const noexcept {
+			return ForEachBlock(reached, [this](const std::size_t begin) noexcept { return CheckBlock(begin); },
+				[this](const std::size_t index) noexcept { return IsReached(index); });
+		}
+
+		/// @brief 重置所有计数器
+		void ResetAll() noexcept { std::ranges::fill(CurrentList, TNumber{}); }
+
+		/// @brief 重置掩码中选中的计数器，例如本帧重新观测到的目标
+		void ResetSelected(const std::span<const MaskWord> selected) noexcept {
+			ForEachSelected(selected, [this](const std::size_t index) noexcept { CurrentList[index] = 0; });
+		}
+
+		/// @brief 遍历掩码中选中的序号
+		static void ForEachSelected(const std::span<const MaskWord> selected, auto&& visitor) noexcept {
+			for (std::size_t word = 0; word < selected.size(); ++word) {
+				for (auto bits = selected[word]; bits != 0; bits &= bits - 1)
+					visitor(word * MaskWordBits + static_cast<std::size_t>(std::countr_zero(bits)));
+			}
+		}
+
+		/// @brief 把掩码转换为序号列表，列表会被清空，已有的容量会被复用
+		static void ToIndexList(const std::span<const MaskWord> selected, std::vector<std::size_t>& indices) {
+			indices.clear();
+			ForEachSelected(selected, [&indices](const std::size_t index) { indices.push_back(index); });
+		}
+
+	};
+
+	using CounterBank8 = CounterBank<std::uint8_t>;
+	using CounterBank16 = CounterBank<std::uint16_t>;
+	using CounterBank32 = CounterBank<std::uint32_t>;
+	using CounterBank64 = CounterBank<std::uint64_t>;
+}
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <coroutine>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <Cango/CommonUtils/AsyncItemPool.hpp>
+#include <spdlog/logger.h>
+#include <spdlog/spdlog.h>
+
+namespace Cango :: inline CommonUtils {
+	/// @brief 运行在 @c EventLoop 中的协程任务，创建后不会立即执行，需要交给 @c EventLoop::Spawn 。
+	///	@details 任务只能交给事件循环运行，不能被其他协程等待。任务中抛出的异常会终止程序。
+	class LoopTask {
+	public:
+		struct promise_type {
+			LoopTask get_return_object() noexcept {
+				return LoopTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+			}
+
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			std::suspend_always final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			[[noreturn]] void unhandled_exception() noexcept { std::terminate(); }
+		};
+
+		using HandleType = std::coroutine_handle<promise_type>;
+
+	private:
+		HandleType Handle;
+
+		explicit LoopTask(const HandleType handle) noexcept : Handle(handle) {}
+
+	public:
+		LoopTask(const LoopTask&) = delete;
+		LoopTask& operator=(const LoopTask&) = delete;
+
+		LoopTask(LoopTask&& other) noexcept : Handle(std::exchange(other.Handle, {})) {}
+
+		LoopTask& operator=(LoopTask&& other) noexcept {
+			if (this != &other) {
+				if (Handle) Handle.destroy();
+				Handle = std::exchange(other.Handle, {});
+			}
+			return *this;
+		}
+
+		~LoopTask() noexcept { if (Handle) Handle.destroy(); }
+
+		/// @brief 交出协程的所有权
+		[[nodiscard]] HandleType Release() noexcept { return std::exchange(Handle, {}); }
+	};
+
+	/// @brief 注册到 @c EventLoop 中的文件描述符的监视者，文件描述符可读时在事件循环的线程中被调用
+	class EventLoopWatcher {
+	public:
+		virtual ~EventLoopWatcher() noexcept = default;
+
+		virtual void OnReadable() noexcept = 0;
+	};
+
+	/// @brief 单线程的协程事件循环，使用一个 epoll 和一个 timerfd 驱动所有的协程。
+	///	@details
+	///		所有协程都在调用 @c Run 的线程中执行，协程之间的切换不需要操作系统参与。
+	///		所有的定时等待共享同一个 timerfd ，由最小堆决定下一次唤醒的时间。
+	///		需要多个核心时，每个核心运行一个事件循环。
+	class EventLoop {
+	public:
+		using ClockType = std::chrono::steady_clock;
+
+	private:
+		struct TimerEntry {
+			ClockType::time_point Deadline;
+			std::coroutine_handle<> Handle;
+
+			bool operator>(const TimerEntry& other) const noexcept { return Deadline > other.Deadline; }
+		};
+
+		int EpollFD{-1};
+		int TimerFD{-1};
+		int WakeFD{-1};
+		std::atomic<std::thread::id> LoopThread{};
+		std::atomic_bool IsStopRequested{false};
+
+		std::vector<LoopTask::HandleType> Tasks{};
+		std::vector<std::coroutine_handle<>> ReadyList{};
+		std::vector<std::coroutine_handle<>> RunningList{};
+		std::priority_queue<TimerEntry, std::vector<TimerEntry>, std::greater<>> Timers{};
+		ClockType::time_point ArmedDeadline{ClockType::time_point::max()};
+
+		void ArmTimer() noexcept;
+
+		void ExpireTimers() noexcept;
+
+		void ResumeReady() noexcept;
+
+		void Close() noexcept;
+
+	public:
+		EventLoop() noexcept = default;
+
+		EventLoop(const EventLoop&) = delete;
+		EventLoop& operator=(const EventLoop&) = delete;
+
+		/// @brief 销毁所有尚未完成的任务
+		~EventLoop() noexcept;
+
+		/// @brief 创建 epoll timerfd 以及用于跨线程唤醒的 eventfd
+		[[nodiscard]] bool Initialize(spdlog::logger& logger) noexcept;
+
+		[[nodiscard]] bool Initialize() noexcept { return Initialize(*spdlog::default_logger()); }
+
+		/// @brief 运行事件循环，直到调用 @c Stop 或者所有任务都已完成
+		void Run() noexcept;
+
+		/// @brief 请求停止事件循环，可以在任何线程中调用
+		void Stop() noexcept;
+
+		/// @brief 当前线程是否为运行事件循环的线程
+		[[nodiscard]] bool IsInLoopThread() const noexcept {
+			return LoopThread.load(std::memory_order_relaxed) == std::this_thread::get_id();
+		}
+
+		/// @brief 接管任务，任务会在下一次调度时开始执行
+		void Spawn(LoopTask task) noexcept;
+
+		/// @brief 在下一次调度时恢复协程，只能在事件循环的线程中调用
+		void Schedule(const std::coroutine_handle<> handle) noexcept { ReadyList.push_back(handle); }
+
+		/// @brief 在给定的时间点之后恢复协程，只能在事件循环的线程中调用
+		void ScheduleAt(ClockType::time_point deadline, std::coroutine_handle<> handle) noexcept;
+
+		/// @brief 监视文件描述符，文件描述符可读时（边沿触发）调用监视者
+		[[nodiscard]] bool Watch(spdlog::logger& logger, int fd, EventLoopWatcher& watcher) noexcept;
+
+		void Unwatch(int fd) noexcept;
+
+		/// @brief 创建非阻塞的 eventfd ，用于从其他线程唤醒事件循环中的协程，失败时返回 -1
+		[[nodiscard]] static int CreateNotifier(spdlog::logger& logger) noexcept;
+
+		static void Notify(int fd) noexcept;
+
+		/// @brief 读取并清空 eventfd 或 timerfd 的计数
+		static std::uint64_t Drain(int fd) noexcept;
+
+		static void CloseNotifier(int fd) noexcept;
+	};
+
+	/// @brief 协程版本的固定间隔休眠器，语义与 @c IntervalSleeperX 相同。
+	///	@details
+	///		使用 @c co_await @c sleeper.NextTick() 代替 @c sleeper.Sleep() ，等待期间让出线程给其他协程。
+	///		从上一次调用开始计时，如果时间间隔小于 Interval，则等待 Interval - 时间间隔，若超过了 Interval，则直接返回。
+	template <typename TDuration>
+	class CoroutineIntervalSleeperX final {
+		EventLoop* Loop;
+		EventLoop::ClockType::time_point LastSleepTime{};
+
+	public:
+		using DurationType = TDuration;
+		using ClockType = EventLoop::ClockType;
+
+		static constexpr TDuration DefaultInterval{100};
+
+		TDuration Interval;
+
+		explicit CoroutineIntervalSleeperX(EventLoop& loop, const TDuration interval = DefaultInterval) noexcept :
+			Loop(&loop), Interval(interval) {}
+
+		class TickAwaiter {
+			CoroutineIntervalSleeperX& Sleeper;
+			ClockType::time_point Deadline{};
+
+		public:
+			explicit TickAwaiter(CoroutineIntervalSleeperX& sleeper) noexcept : Sleeper(sleeper) {}
+
+			bool await_ready() noexcept {
+				if (Sleeper.Interval.count() == 0) return true; // 对于 0 延时的特别处理
+
+				const auto now = ClockType::now();
+				if (now - Sleeper.LastSleepTime >= Sleeper.Interval) {
+					Sleeper.LastSleepTime = now;
+					return true;
+				}
+				Sleeper.LastSleepTime += Sleeper.Interval;
+				Deadline = Sleeper.LastSleepTime;
+				return false;
+			}
+
+			void await_suspend(const std::coroutine_handle<> handle) noexcept { Sleeper.Loop->ScheduleAt(Deadline, handle); }
+
+			void await_resume() noexcept {}
+		};
+
+		/// @brief 等待下一个时间点
+		[[nodiscard]] TickAwaiter NextTick() noexcept { return TickAwaiter{*this}; }
+	};
+
+	using CoroutineIntervalSleeper = CoroutineIntervalSleeperX<std::chrono::milliseconds>;
+
+	/// @brief 可以被协程等待的三重物品缓冲池。
+	///	@details
+	///		读取者是事件循环中的一个协程，使用 @c co_await @c pool.NextItem() 等待新的物品。
+	///		写入者可以是同一个事件循环中的协程，也可以是其他线程。
+	///		只有读取者正在等待时，写入才会唤醒读取者；其他线程写入时通过 eventfd 唤醒，同一线程写入时直接调度。
+	///		读取发生在事件循环的回调中，所以要求物品的交换不会抛出异常。
+	template <std::default_initializable TItem>
+		requires TripleItemPool<TItem>::IsNothrowSwap
+	class CoroutineItemPool final : EventLoopWatcher {
+		EventLoop* Loop;
+		TripleItemPool<TItem> Pool{};
+		int NotifierFD{-1};
+		std::atomic_bool IsWaiting{false};
+		std::coroutine_handle<> Waiter{};
+		TItem* Target{nullptr};
+
+		/// @brief 读取者正在等待时，尝试取出物品并恢复读取者，只在事件循环的线程中调用
+		void Deliver() noexcept {
+			if (!Waiter) return;
+			if (!Pool.GetItem(*Target)) {
+				// 物品已经被取走，重新开始等待
+				IsWaiting.store(true, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (!Pool.GetItem(*Target)) return;
+				IsWaiting.store(false, std::memory_order_relaxed);
+			}
+			Loop->Schedule(std::exchange(Waiter, {}));
+		}
+
+		void OnReadable() noexcept override {
+			EventLoop::Drain(NotifierFD);
+			Deliver();
+		}
+
+	public:
+		using ItemType = TItem;
+
+		explicit CoroutineItemPool(EventLoop& loop) noexcept : Loop(&loop) {}
+
+		CoroutineItemPool(const CoroutineItemPool&) = delete;
+		CoroutineItemPool& operator=(const CoroutineItemPool&) = delete;
+
+		~CoroutineItemPool() noexcept override {
+			if (NotifierFD == -1) return;
+			Loop->Unwatch(NotifierFD);
+			EventLoop::CloseNotifier(NotifierFD);
+		}
+
+		/// @brief 创建用于唤醒读取者的 eventfd 并注册到事件循环中
+		[[nodiscard]] bool Initialize(spdlog::logger& logger) noexcept {
+			NotifierFD = EventLoop::CreateNotifier(logger);
+			if (NotifierFD == -1) return false;
+			if (Loop->Watch(logger, NotifierFD, *this)) return true;
+			EventLoop::CloseNotifier(NotifierFD);
+			NotifierFD = -1;
+			return false;
+		}
+
+		[[nodiscard]] bool Initialize() noexcept { return Initialize(*spdlog::default_logger()); }
+
+		/// @brief 向数据池中写入数据，不阻塞当前线程，读取者正在等待时唤醒读取者
+		void SetItem(const TItem& item) noexcept(TripleItemPool<TItem>::IsNothrowCopy) {
+			Pool.SetItem(item);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (!IsWaiting.exchange(false, std::memory_order_relaxed)) return;
+			if (Loop->IsInLoopThread()) Deliver();
+			else EventLoop::Notify(NotifierFD);
+		}
+
+		/// @brief 从数据池中获取数据，不阻塞当前线程。在没有找到任何准备好的物品时，操作将会失败
+		[[nodiscard]] bool GetItem(TItem& item) noexcept { return Pool.GetItem(item); }
+
+		class ItemAwaiter {
+			CoroutineItemPool& Owner;
+			TItem Item{};
+
+		public:
+			explicit ItemAwaiter(CoroutineItemPool& owner) noexcept : Owner(owner) {}
+
+			bool await_ready() noexcept { return Owner.Pool.GetItem(Item); }
+
+			bool await_suspend(const std::coroutine_handle<> handle) noexcept {
+				Owner.Target = &Item;
+				Owner.Waiter = handle;
+				Owner.IsWaiting.store(true, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				// 在标记等待之前写入的物品不会唤醒读取者，需要再检查一次
+				if (!Owner.Pool.GetItem(Item)) return true;
+				Owner.IsWaiting.store(false, std::memory_order_relaxed);
+				Owner.Waiter = {};
+				return false;
+			}
+
+			TItem await_resume() noexcept { return std::move(Item); }
+		};
+
+		/// @brief 等待下一个物品，同一时间只能有一个协程等待
+		[[nodiscard]] ItemAwaiter NextItem() noexcept { return ItemAwaiter{*this}; }
+	};
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <Cango/CommonUtils/AsyncItemPool.hpp>
+#include <Cango/CommonUtils/SharedItemPool.hpp>
+#include <boost/filesystem/path.hpp>
+#include <spdlog/logger.h>
+#include <spdlog/spdlog.h>
+
+namespace Cango :: inline CommonUtils {
+	/// @brief 捕获文件的头部，位于文件的起始位置
+	struct ItemPoolCaptureHeader {
+		static constexpr std::uint32_t MagicValue = 0x43504943; // "CIPC"
+		static constexpr std::uint32_t CurrentVersion = 1;
+
+		std::uint32_t Magic{};
+		std::uint32_t Version{};
+		std::uint64_t ItemSize{};
+		std::uint64_t TypeHash{};
+		std::uint64_t RecordStride{};
+		std::uint64_t Capacity{};
+
+		/// @brief 已经追加的记录总数，超过容量后旧的记录会被覆盖
+		std::atomic_uint64_t WriteCount{0};
+	};
+
+	/// @brief 捕获文件中每条记录的头部，物品的字节紧随其后
+	struct ItemPoolCaptureRecord {
+		enum Kind : std::uint32_t {
+			Set = 0,
+			Get = 1
+		};
+
+		/// @brief 记录的序号加一，为零表示记录正在写入或者尚未写入
+		std::atomic_uint64_t Sequence{0};
+		/// @brief 自 steady_clock 纪元开始的纳秒数
+		std::int64_t Timestamp{};
+		std::uint32_t RecordKind{};
+		std::uint32_t Reserved{};
+
+		[[nodiscard]] const void* GetItemBytes() const noexcept { return this + 1; }
+	};
+
+	/// @brief 物品池的捕获文件，以内存映射的环形缓冲区记录带时间戳的物品字节。
+	///	@details
+	///		追加记录只涉及一次原子加法、一次读取时钟和一次内存复制，不会产生系统调用。
+	///		文件写满后覆盖最旧的记录，内核负责把映射的页面写回文件。
+	///		可以在多个线程中同时追加记录。
+	class ItemPoolCaptureFile {
+		std::string PathString{};
+		ItemPoolCaptureHeader* Header{nullptr};
+		std::uint8_t* Records{nullptr};
+		std::size_t MappedSize{0};
+		bool Writable{false};
+
+		[[nodiscard]] ItemPoolCaptureRecord* GetRecord(std::uint64_t slot) const noexcept;
+
+	public:
+		using FilePathType = boost::filesystem::path;
+
+		ItemPoolCaptureFile() noexcept = default;
+
+		ItemPoolCaptureFile(const ItemPoolCaptureFile&) = delete;
+		ItemPoolCaptureFile& operator=(const ItemPoolCaptureFile&) = delete;
+
+		~ItemPoolCaptureFile() noexcept;
+
+		/// @brief 创建新的捕获文件，已经存在的文件会被覆盖
+		///	@param capacity 环形缓冲区能够容纳的记录数量
+		[[nodiscard]] bool Create(
+			spdlog::logger& logger,
+			const FilePathType& file,
+			std::size_t itemSize,
+			std::uint64_t typeHash,
+			std::size_t capacity) noexcept;
+
+		/// @brief 以只读的方式打开捕获文件，检查头部信息是否与给定的物品大小和类型哈希一致
+		[[nodiscard]] bool Open(
+			spdlog::logger& logger,
+			const FilePathType& file,
+			std::size_t itemSize,
+			std::uint64_t typeHash) noexcept;
+
+		void Close() noexcept;
+
+		[[nodiscard]] bool IsOpen() const noexcept { return Header != nullptr; }
+
+		/// @brief 是否以写入的方式打开，只有通过 @c Create 打开的文件才能追加记录
+		[[nodiscard]] bool IsWritable() const noexcept { return Writable; }
+
+		/// @brief 追加一条记录，调用方保证文件以写入的方式打开并且数据大小为 ItemSize
+		void Append(ItemPoolCaptureRecord::Kind kind, const void* data) noexcept {
+			const auto index = Header->WriteCount.fetch_add(1, std::memory_order_relaxed);
+			auto* record = GetRecord(index % Header->Capacity);
+			record->Sequence.store(0, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			record->Timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+			record->RecordKind = kind;
+			std::memcpy(reinterpret_cast<std::uint8_t*>(record + 1), data, Header->ItemSize);
+			record->Sequence.store(index + 1, std::memory_order_release);
+		}
+
+		/// @brief 按照追加的顺序遍历仍然保存在文件中的完整记录
+		///	@param visitor 接受 @c const @c ItemPoolCaptureRecord& 的可调用对象
+		void ForEachRecord(auto&& visitor) const noexcept {
+			const auto count = Header->WriteCount.load(std::memory_order_acquire);
+			const auto begin = count > Header->Capacity ? count - Header->Capacity : 0;
+			for (auto index = begin; index < count; ++index) {
+				const auto& record = *GetRecord(index % Header->Capacity);
+				if (record.Sequence.load(std::memory_order_acquire) != index + 1) continue;
+				visitor(record);
+			}
+		}
+	};
+
+	/// @brief 带有可选捕获功能的三重物品缓冲池，接口与 @c TripleItemPool 一致。
+	///	@details
+	///		在调用 @c StartCapture 之前不记录任何内容，开销仅为一次原子读取。
+	///		开始捕获后，每次 @c SetItem 和成功的 @c GetItem 都会在捕获文件中追加一条记录。
+	///		可以在读取者和写入者运行时开始或停止捕获，停止时会等待正在追加的记录完成后再关闭文件。
+	///		开始和停止捕获需要在同一个控制线程中调用，不能互相并发。
+	///	@note
+	///		物品以字节的形式记录，所以只接受可平凡复制的类型。
+	///		持有堆内存的物品（例如包含 @c std::vector 或 @c std::string ）不能直接捕获，
+	///		需要由调用者转换为定长的可平凡复制类型后再使用本类。
+	///	@tparam TItem 数据池中存储的物品的类型
+	template <typename TItem>
+		requires std::default_initializable<TItem> && std::is_trivially_copyable_v<TItem>
+	class CapturedTripleItemPool final {
+		TripleItemPool<TItem> Pool{};
+		ItemPoolCaptureFile Capture{};
+		/// @brief 正在捕获时指向 @c Capture ，否则为空
+		std::atomic<ItemPoolCaptureFile*> ActiveCapture{nullptr};
+		/// @brief 正在追加记录的线程数量，停止捕获时等待其归零后才能关闭文件
+		std::atomic_uint32_t AppendingCount{0};
+
+		void Append(const ItemPoolCaptureRecord::Kind kind, const TItem& item) noexcept {
+			if (ActiveCapture.load(std::memory_order_relaxed) == nullptr) return;
+
+			// 与 StopCapture 中的清空指针和读取计数配对，二者至少有一方能看到对方的修改
+			AppendingCount.fetch_add(1, std::memory_order_seq_cst);
+			if (auto* capture = ActiveCapture.load(std::memory_order_seq_cst)) capture->Append(kind, &item);
+			AppendingCount.fetch_sub(1, std::memory_order_release);
+		}
+
+	public:
+		using ItemType = TItem;
+
+		CapturedTripleItemPool() noexcept = default;
+
+		CapturedTripleItemPool(const CapturedTripleItemPool&) = delete;
+		CapturedTripleItemPool& operator=(const CapturedTripleItemPool&) = delete;
+
+		~CapturedTripleItemPool() noexcept { StopCapture(); }
+
+		/// @brief 开始捕获到给定的文件，每个物品池应当使用单独的文件，正在捕获时会先停止之前的捕获
+		[[nodiscard]] bool StartCapture(
+			spdlog::logger& logger,
+			const ItemPoolCaptureFile::FilePathType& file,
+			const std::size_t capacity) noexcept {
+			StopCapture();
+			if (!Capture.Create(logger, file, sizeof(TItem), GetStableTypeHash<TItem>(), capacity)) return false;
+			ActiveCapture.store(&Capture, std::memory_order_seq_cst);
+			return true;
+		}
+
+		[[nodiscard]] bool StartCapture(const ItemPoolCaptureFile::FilePathType& file, const std::size_t capacity) noexcept {
+			return StartCapture(*spdlog::default_logger(), file, capacity);
+		}
+
+		/// @brief 停止捕获，等待其他线程追加完正在写入的记录后关闭文件
+		void StopCapture() noexcept {
+			if (ActiveCapture.exchange(nullptr, std::memory_order_seq_cst) == nullptr) return;
+			while (AppendingCount.load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
+			std::atomic_thread_fence(std::memory_order_acquire);
+			Capture.Close();
+		}
+
+		/// @brief 是否正在捕获
+		[[nodiscard]] bool IsCapturing() const noexcept {
+			return ActiveCapture.load(std::memory_order_relaxed) != nullptr;
+		}
+
+		/// @brief 向数据池中写入数据，不阻塞当前线程
+		void SetItem(const TItem& item) noexcept {
+			Append(ItemPoolCaptureRecord::Set, item);
+			Pool.SetItem(item);
+		}
+
+		/// @brief 从数据池中获取数据，不阻塞当前线程。在没有找到任何准备好的物品时，操作将会失败
+		[[nodiscard]] bool GetItem(TItem& item) noexcept {
+			if (!Pool.GetItem(item)) return false;
+			Append(ItemPoolCaptureRecord::Get, item);
+			return true;
+		}
+	};
+
+	/// @brief 回放捕获文件中写入的物品，用于以真实的负载离线测试读取者
+	template <typename TItem>
+		requires std::default_initializable<TItem> && std::is_trivially_copyable_v<TItem>
+	class ItemPoolReplayer final {
+		ItemPoolCaptureFile Capture{};
+
+	public:
+		using ItemType = TItem;
+
+		[[nodiscard]] bool Open(spdlog::logger& logger, const ItemPoolCaptureFile::FilePathType& file) noexcept {
+			return Capture.Open(logger, file, sizeof(TItem), GetStableTypeHash<TItem>());
+		}
+
+		[[nodiscard]] bool Open(const ItemPoolCaptureFile::FilePathType& file) noexcept {
+			return Open(*spdlog::default_logger(), file);
+		}
+
+		/// @brief 获取捕获文件，用于分析读取记录等其他内容
+		[[nodiscard]] const ItemPoolCaptureFile& GetCapture() const noexcept { return Capture; }
+
+		/// @brief 按照捕获时的时间间隔，把写入记录依次写入到给定的物品池中
+		///	@param pool 任何提供 @c SetItem(const TItem&) 的物品池
+		///	@param speed 回放速度倍率，为 1 时按原速回放，小于等于 0 时不等待，尽可能快地回放
+		///	@return 回放的物品数量
+		std::size_t Replay(auto& pool, const double speed = 1.0) noexcept {
+			std::size_t count = 0;
+			std::int64_t first_timestamp = 0;
+			const auto begin = std::chrono::steady_clock::now();
+			TItem item{};
+
+			Capture.ForEachRecord([&](const ItemPoolCaptureRecord& record) noexcept {
+				if (record.RecordKind != ItemPoolCaptureRecord::Set) return;
+				if (count == 0) first_timestamp = record.Timestamp;
+
+				if (speed > 0) {
+					const std::chrono::nanoseconds offset{
+						static_cast<std::int64_t>(static_cast<double>(record.Timestamp - first_timestamp) / speed)
+					};
+					std::this_thread::sleep_until(begin + offset);
+				}
+
+				std::memcpy(&item, record.GetItemBytes(), sizeof(TItem));
+				pool.SetItem(item);
+				++count;
+			});
+			return count;
+		}
+	};
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/logger.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/spdlog.h>
+
+namespace Cango :: inline CommonUtils {
+	/// @brief 基于内存映射的分段日志文件，追加日志只是一次内存复制，不会产生系统调用。
+	///	@details
+	///		每个分段在创建时预先分配磁盘空间并映射到内存中，日志直接复制到映射的页面里。
+	///		进程崩溃时页面仍然由内核持有并写回文件，已经追加的日志不会丢失。
+	///		后台线程预先创建下一个分段，当前分段写满时只需要切换指针；
+	///		关闭的分段也由后台线程截断到实际长度，并且可以压缩为 gzip 文件。
+	///		分段文件命名为 BaseName + 五位序号 + ".log" 。
+	///		打开时从已经存在的分段（包括压缩后的分段）中最大的序号之后继续编号，不会覆盖之前的日志。
+	///		切换分段时如果后台线程还没有创建好下一个分段，日志线程会阻塞等待，而不是丢弃日志。
+	///		后台线程按顺序创建分段和处理关闭的分段，启用压缩后，写满一个分段的时间短于压缩一个分段的时间时，
+	///		每次切换都要等待压缩结束，此时应增大分段或者关闭压缩。
+	///		只有创建分段失败之后才会丢弃日志并计入 @c GetDroppedCount ，直到下一个分段创建成功。
+	///
+	///	@note
+	///		进程崩溃时分段不会被截断，文件末尾是未使用的零字节，可以用 @c tr @c -d @c '\0' 去掉。
+	///		追加日志不是线程安全的，需要由调用者加锁，例如 @c MappedFileSinkX 。
+	///		打开之后的错误输出到 @c std::cerr ，因为此时日志器可能正在使用这个文件。
+	class MappedLogFile {
+	public:
+		struct Configuration {
+			std::string BaseName{};
+			/// @brief 每个分段的大小，会向上对齐到页面大小
+			std::size_t SegmentSize{5 * 1024 * 1024};
+			/// @brief 是否把关闭的分段压缩为 gzip 文件并删除原文件
+			///	@details 需要在构建时打开 Cango_CommonUtils_EnableLogCompression ，否则 @c Open 失败
+			bool CompressClosedSegments{false};
+		};
+
+	private:
+		struct Segment {
+			std::string Path{};
+			int FD{-1};
+			char* Data{nullptr};
+			std::size_t Used{0};
+		};
+
+		Configuration Config{};
+		std::size_t SegmentSize{0};
+		std::uint64_t NextIndex{0};
+		Segment Current{};
+		std::uint64_t DroppedCount{0};
+		bool IsOpened{false};
+
+		std::mutex WorkerMutex{};
+		std::condition_variable WorkerCondition{};
+		std::thread Worker{};
+		bool IsStopRequested{false};
+		/// @brief 后台线程尚未开始创建请求的分段
+		bool IsPrepareRequested{false};
+		/// @brief 从请求创建分段到创建结束（成功或失败）
+		bool IsPreparing{false};
+		/// @brief 请求创建的分段序号，创建时跳过已经存在的文件后更新为实际使用的序号
+		std::uint64_t PrepareIndex{0};
+		Segment Prepared{};
+		std::vector<Segment> ClosedSegments{};
+
+		[[nodiscard]] std::string GetSegmentPath(std::uint64_t index) const;
+
+		/// @brief 查找已经存在的分段中最大的序号，返回它的下一个序号
+		[[nodiscard]] std::uint64_t FindNextIndex() const;
+
+		/// @brief 从给定的序号开始创建分段，同名文件已经存在时跳过该序号，成功后 @c index 为实际使用的序号
+		[[nodiscard]] bool CreateSegment(std::uint64_t& index, Segment& segment, std::string& error) const noexcept;
+
+		[[nodiscard]] static bool CompressSegment(const Segment& segment) noexcept;
+
+		void FinishSegment(Segment& segment) const noexcept;
+
+		void RemoveSegment(Segment& segment) const noexcept;
+
+		/// @brief 请求后台线程创建下一个分段，需要持有 WorkerMutex
+		void RequestPrepare() noexcept;
+
+		/// @brief 关闭当前分段并切换到预先创建的下一个分段
+		bool Rotate() noexcept;
+
+		void RunWorker() noexcept;
+
+	public:
+		MappedLogFile() noexcept = default;
+
+		MappedLogFile(const MappedLogFile&) = delete;
+		MappedLogFile& operator=(const MappedLogFile&) = delete;
+
+		~MappedLogFile() noexcept;
+
+		/// @brief 创建第一个分段并启动后台线程，序号接在已经存在的分段之后
+		[[nodiscard]] bool Open(spdlog::logger& logger, Configuration config) noexcept;
+
+		[[nodiscard]] bool Open(Configuration config) noexcept { return Open(*spdlog::default_logger(), std::move(config)); }
+
+		/// @brief 关闭所有分段并等待后台线程处理完关闭的分段
+		void Close() noexcept;
+
+		/// @brief 追加一段文本，当前分段放不下时切换到下一个分段，超过分段大小的文本会被截断
+		void Append(std::string_view text) noexcept;
+
+		/// @brief 因为无法创建分段而丢弃的日志数量
+		[[nodiscard]] std::uint64_t GetDroppedCount() const noexcept { return DroppedCount; }
+
+		/// @brief 当前分段的路径
+		[[nodiscard]] const std::string& GetCurrentPath() const noexcept { return Current.Path; }
+	};
+
+	/// @brief 使用 @c MappedLogFile 的 spdlog 输出，替代 @c rotating_file_sink 。
+	///	@details 数据写入映射后就已经交给了内核，所以 flush 不需要任何操作。
+	template <typename TMutex>
+	class MappedFileSinkX final : public spdlog::sinks::base_sink<TMutex> {
+		MappedLogFile File{};
+
+	protected:
+		void sink_it_(const spdlog::details::log_msg& message) override {
+			spdlog::memory_buf_t formatted{};
+			spdlog::sinks::base_sink<TMutex>::formatter_->format(message, formatted);
+			File.Append({formatted.data(), formatted.size()});
+		}
+
+		void flush_() override {}
+
+	public:
+		using ConfigurationType = MappedLogFile::Configuration;
+
+		[[nodiscard]] bool Open(spdlog::logger& logger, ConfigurationType config) noexcept {
+			std::lock_guard lock{spdlog::sinks::base_sink<TMutex>::mutex_};
+			return File.Open(logger, std::move(config));
+		}
+
+		[[nodiscard]] bool Open(ConfigurationType config) noexcept { return Open(*spdlog::default_logger(), std::move(config)); }
+
+		[[nodiscard]] std::uint64_t GetDroppedCount() noexcept {
+			std::lock_guard lock{spdlog::sinks::base_sink<TMutex>::mutex_};
+			return File.GetDroppedCount();
+		}
+	};
+
+	using MappedFileSinkMT = MappedFileSinkX<std::mutex>;
+	using MappedFileSinkST = MappedFileSinkX<spdlog::details::null_mutex>;
+}
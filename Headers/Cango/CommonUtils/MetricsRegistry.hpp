@@ -0,0 +1,227 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <boost/filesystem/path.hpp>
+#include <spdlog/logger.h>
+#include <spdlog/spdlog.h>
+
+namespace Cango :: inline CommonUtils {
+	/// @brief 指标的种类
+	enum class MetricKind : std::uint32_t {
+		Counter = 0,
+		Rate = 1,
+		Gauge = 2,
+		Histogram = 3
+	};
+
+	/// @brief 指标在注册表中的存储位置，所有更新都使用宽松的原子操作
+	///	@details
+	///		计数器和速率使用 @c Value 累计次数，速率由导出器根据两次导出之间的差值计算。
+	///		测量值把 double 的位存储在 @c Value 中。
+	///		直方图按照数值的二进制位数分桶，第 i 个桶记录 [2^(i-1), 2^i - 1] 范围内的数值，第 0 个桶记录 0 。
+	struct alignas(64) MetricSlot {
+		static constexpr std::size_t MaxNameLength = 47;
+		static constexpr std::size_t BucketCount = 65;
+
+		std::array<char, MaxNameLength + 1> Name{};
+		MetricKind Kind{};
+		std::atomic_uint64_t Value{0};
+		std::atomic_uint64_t Sum{0};
+		std::array<std::atomic_uint64_t, BucketCount> Buckets{};
+	};
+
+	/// @brief 计数器，记录事件发生的总次数
+	class MetricCounter {
+		MetricSlot* Slot;
+
+	public:
+		explicit MetricCounter(MetricSlot& slot) noexcept : Slot(&slot) {}
+
+		void Add(const std::uint64_t count = 1) const noexcept { Slot->Value.fetch_add(count, std::memory_order_relaxed); }
+
+		[[nodiscard]] std::uint64_t Get() const noexcept { return Slot->Value.load(std::memory_order_relaxed); }
+	};
+
+	/// @brief 速率，与 @c CallRateCounterX 的用法相同，每次调用记录一次，频率由导出器计算
+	class MetricRate {
+		MetricSlot* Slot;
+
+	public:
+		explicit MetricRate(MetricSlot& slot) noexcept : Slot(&slot) {}
+
+		void Call() const noexcept { Slot->Value.fetch_add(1, std::memory_order_relaxed); }
+	};
+
+	/// @brief 测量值，记录某个量的当前值
+	class MetricGauge {
+		MetricSlot* Slot;
+
+	public:
+		explicit MetricGauge(MetricSlot& slot) noexcept : Slot(&slot) {}
+
+		void Set(const double value) const noexcept {
+			Slot->Value.store(std::bit_cast<std::uint64_t>(value), std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] double Get() const noexcept {
+			return std::bit_cast<double>(Slot->Value.load(std::memory_order_relaxed));
+		}
+	};
+
+	/// @brief 直方图，按照二进制位数记录数值的分布，适合记录耗时（纳秒、微秒）等跨度较大的量
+	class MetricHistogram {
+		MetricSlot* Slot;
+
+	public:
+		explicit MetricHistogram(MetricSlot& slot) noexcept : Slot(&slot) {}
+
+		void Record(const std::uint64_t value) const noexcept {
+			Slot->Buckets[std::bit_width(value)].fetch_add(1, std::memory_order_relaxed);
+			Slot->Sum.fetch_add(value, std::memory_order_relaxed);
+			Slot->Value.fetch_add(1, std::memory_order_relaxed);
+		}
+	};
+
+	/// @brief 进程内的指标注册表，所有指标在启动时注册一次，之后通过句柄更新。
+	///	@details
+	///		存储空间是固定大小的静态数组，注册和更新都不会分配内存。
+	///		重复注册同名同种类的指标会得到同一个存储位置。
+	///		注册失败（名称过长、种类冲突、数量超出上限）时会输出错误，并返回一个不会被导出的占位存储位置，
+	///		调用方无需检查返回值，更新占位指标不会产生任何影响。
+	class MetricsRegistry {
+	public:
+		static constexpr std::size_t MaxMetricCount = 256;
+
+	private:
+		std::mutex RegisterMutex{};
+		std::atomic_size_t Count{0};
+		std::array<MetricSlot, MaxMetricCount> Slots{};
+		MetricSlot DiscardedSlot{};
+
+		MetricsRegistry() noexcept = default;
+
+		MetricSlot& Register(spdlog::logger& logger, std::string_view name, MetricKind kind) noexcept;
+
+	public:
+		MetricsRegistry(const MetricsRegistry&) = delete;
+		MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+		/// @brief 获取进程内唯一的注册表
+		static MetricsRegistry& Instance() noexcept;
+
+		MetricCounter RegisterCounter(spdlog::logger& logger, std::string_view name) noexcept;
+		MetricCounter RegisterCounter(std::string_view name) noexcept;
+
+		MetricRate RegisterRate(spdlog::logger& logger, std::string_view name) noexcept;
+		MetricRate RegisterRate(std::string_view name) noexcept;
+
+		MetricGauge RegisterGauge(spdlog::logger& logger, std::string_view name) noexcept;
+		MetricGauge RegisterGauge(std::string_view name) noexcept;
+
+		MetricHistogram RegisterHistogram(spdlog::logger& logger, std::string_view name) noexcept;
+		MetricHistogram RegisterHistogram(std::string_view name) noexcept;
+
+		/// @brief 已经注册的指标数量
+		[[nodiscard]] std::size_t GetCount() const noexcept { return Count.load(std::memory_order_acquire); }
+
+		/// @brief 获取已经注册的指标，调用方保证 index 小于 @c GetCount()
+		[[nodiscard]] const MetricSlot& GetSlot(const std::size_t index) const noexcept { return Slots[index]; }
+	};
+
+	/// @brief 导出到共享内存中的一个指标的快照
+	struct MetricSnapshotEntry {
+		std::array<char, MetricSlot::MaxNameLength + 1> Name{};
+		MetricKind Kind{};
+		/// @brief 计数器、速率、直方图的总次数
+		std::uint64_t Count{};
+		/// @brief 直方图的数值总和
+		std::uint64_t Sum{};
+		/// @brief 测量值的当前值，或者速率在上一个导出周期内的频率(次/s)
+		double Value{};
+		std::array<std::uint64_t, MetricSlot::BucketCount> Buckets{};
+	};
+
+	/// @brief 共享内存中的指标快照，外部工具可以在不影响进程的情况下读取
+	///	@details 导出器写入快照时 @c Sequence 为奇数，读取者在前后两次读取到相同的偶数时才认为快照完整。
+	struct MetricsSnapshot {
+		static constexpr std::uint32_t MagicValue = 0x434d5452; // "CMTR"
+		static constexpr std::uint32_t CurrentVersion = 1;
+
+		std::uint32_t Magic{};
+		std::uint32_t Version{};
+		std::atomic_uint64_t Sequence{0};
+		/// @brief 导出时 system_clock 的纳秒数
+		std::int64_t Timestamp{};
+		std::uint64_t Count{};
+		std::array<MetricSnapshotEntry, MetricsRegistry::MaxMetricCount> Entries{};
+	};
+
+	/// @brief 从共享内存中读取指标快照，供外部的监控工具使用
+	///	@param name 导出器使用的共享内存名称
+	///	@param snapshot 读取到的快照，读取失败时内容未定义
+	[[nodiscard]] bool ReadMetricsSnapshot(spdlog::logger& logger, std::string_view name, MetricsSnapshot& snapshot) noexcept;
+
+	/// @brief 指标导出器，在后台线程中周期性地把注册表导出到共享内存和 Prometheus 文本文件
+	class MetricsExporter {
+	public:
+		using FilePathType = boost::filesystem::path;
+
+		struct Configuration {
+			/// @brief 共享内存的名称，例如 "/cango_metrics_app" ，为空时不导出到共享内存
+			std::string SharedMemoryName{};
+			/// @brief Prometheus 文本文件的路径，为空时不导出到文件
+			FilePathType PrometheusFile{};
+			std::chrono::milliseconds Interval{1000};
+		};
+
+	private:
+		Configuration Config{};
+		spdlog::logger* Logger{nullptr};
+		MetricsSnapshot* Snapshot{nullptr};
+		/// @brief 没有配置共享内存时，快照存放在这里，仍然可以导出到文件
+		std::unique_ptr<MetricsSnapshot> LocalSnapshot{};
+		std::array<std::uint64_t, MetricsRegistry::MaxMetricCount> LastCounts{};
+		std::chrono::steady_clock::time_point LastExportTime{};
+
+		std::mutex StopMutex{};
+		std::condition_variable StopCondition{};
+		bool IsStopRequested{false};
+		std::thread Worker{};
+
+		void ExportOnce() noexcept;
+
+		void WritePrometheusFile() const noexcept;
+
+		void Release() noexcept;
+
+	public:
+		MetricsExporter() noexcept = default;
+
+		MetricsExporter(const MetricsExporter&) = delete;
+		MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+		~MetricsExporter() noexcept;
+
+		/// @brief 删除给定名称的共享内存，用于清理崩溃的导出器遗留的共享内存，名称不存在时视为成功
+		static bool Remove(spdlog::logger& logger, std::string_view name) noexcept;
+
+		/// @brief 创建共享内存并启动后台线程，日志记录器的生命周期必须长于导出器
+		///	@details 同名的共享内存已经存在时失败，不会接管其他导出器正在使用的共享内存。
+		[[nodiscard]] bool Start(spdlog::logger& logger, Configuration config) noexcept;
+
+		[[nodiscard]] bool Start(Configuration config) noexcept;
+
+		/// @brief 停止后台线程，删除共享内存
+		void Stop() noexcept;
+	};
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <Cango/CommonUtils/AsyncItemPool.hpp>
+#include <boost/type_index.hpp>
+#include <spdlog/logger.h>
+#include <spdlog/spdlog.h>
+
+namespace Cango :: inline CommonUtils {
+	/// @brief 共享内存三重缓冲区的头部，位于共享内存段的起始位置。
+	///	@details
+	///		创建者负责初始化头部，附加者检查 Magic Version ItemSize TypeHash 后才允许使用。
+	///		每个槽位的状态字中，低 8 位为状态，高位为持有该槽位的进程号，用于在对端进程崩溃后回收槽位。
+	struct SharedTripleByteBufferHeader {
+		static constexpr std::uint32_t MagicValue = 0x43545042; // "CTPB"
+		static constexpr std::uint32_t CurrentVersion = 1;
+		static constexpr std::size_t ItemCount = 3;
+
+		std::uint32_t Magic{};
+		std::uint32_t Version{};
+		std::uint64_t ItemSize{};
+		std::uint64_t TypeHash{};
+		std::uint64_t ItemStride{};
+
+		/// @brief 创建者完成初始化后置为 1，附加者在此之前不得访问槽位
+		std::atomic_uint32_t Ready{0};
+		std::atomic_uint32_t WriterIndex{0};
+		std::atomic_uint64_t StatusList[ItemCount]{};
+	};
+
+	static_assert(std::atomic_uint64_t::is_always_lock_free, "跨进程共享的原子变量必须是无锁的");
+
+	/// @brief 基于 POSIX 共享内存的三重字节缓冲区，用于在两个进程间无阻塞地存取较新的数据。
+	///	@details
+	///		与 @c NonblockTripleByteBuffer 使用相同的槽位协议，但数据位于 shm_open + mmap 映射的共享内存中。
+	///		物品大小在运行时指定，并记录在共享内存的头部中。
+	///		一个共享内存段只允许一个写入者和一个读取者。
+	///		创建者在析构时会删除共享内存的名称，已经附加的进程仍然可以继续使用映射，直到自己析构。
+	class SharedTripleByteBuffer {
+		std::string Name{};
+		SharedTripleByteBufferHeader* Header{nullptr};
+		std::uint8_t* Items{nullptr};
+		std::size_t MappedSize{0};
+		std::uint64_t ProcessID{0};
+		bool IsCreator{false};
+
+		/// @brief 记录映射的地址，调用前 MappedSize 已经设置为映射的大小
+		void SetMapping(void* address) noexcept;
+
+		/// @brief 占用槽位时写入的状态字，高位记录当前进程号
+		[[nodiscard]] std::uint64_t GetBusyStatus() const noexcept;
+
+	public:
+		SharedTripleByteBuffer() noexcept = default;
+
+		SharedTripleByteBuffer(const SharedTripleByteBuffer&) = delete;
+		SharedTripleByteBuffer& operator=(const SharedTripleByteBuffer&) = delete;
+
+		SharedTripleByteBuffer(SharedTripleByteBuffer&& other) noexcept;
+		SharedTripleByteBuffer& operator=(SharedTripleByteBuffer&& other) noexcept;
+
+		~SharedTripleByteBuffer() noexcept;
+
+		/// @brief 计算给定物品大小时共享内存段的总大小
+		[[nodiscard]] static std::size_t GetSegmentSize(std::size_t itemSize) noexcept;
+
+		/// @brief 删除给定名称的共享内存，用于清理崩溃的创建者遗留的共享内存，名称不存在时视为成功
+		static bool Remove(spdlog::logger& logger, std::string_view name) noexcept;
+
+		/// @brief 创建新的共享内存段，如果同名的共享内存已经存在，则失败
+		///	@param name 共享内存的名称，格式要求见 shm_open ，例如 "/perception_to_control"
+		[[nodiscard]] bool Create(
+			spdlog::logger& logger,
+			std::string_view name,
+			std::size_t itemSize,
+			std::uint64_t typeHash) noexcept;
+
+		/// @brief 附加到已经存在的共享内存段，检查头部信息是否与给定的物品大小和类型哈希一致
+		[[nodiscard]] bool Attach(
+			spdlog::logger& logger,
+			std::string_view name,
+			std::size_t itemSize,
+			std::uint64_t typeHash) noexcept;
+
+		/// @brief 解除映射，创建者还会删除共享内存的名称
+		void Close() noexcept;
+
+		[[nodiscard]] bool IsOpen() const noexcept { return Header != nullptr; }
+
+		[[nodiscard]] std::size_t GetItemSize() const noexcept { return Header ? Header->ItemSize : 0; }
+
+		/// @brief 回收被已经退出的进程占用的槽位
+		///	@return 回收的槽位数量
+		std::size_t RecoverAbandonedSlots() noexcept;
+
+		/// @brief 写入一个物品的字节，不阻塞当前线程。调用方保证已经打开并且数据大小为 ItemSize
+		void WriteBytes(const void* data) noexcept;
+
+		/// @brief 读取最新的物品字节，不阻塞当前线程。在没有找到任何准备好的物品时，操作将会失败
+		[[nodiscard]] bool ReadBytes(void* data) noexcept;
+	};
+
+	/// @brief 计算类型的哈希，用于在附加共享内存时检查两端的物品类型是否一致
+	///	@details 使用 FNV-1a 计算类型名称的哈希，相同的编译器得到的结果是稳定的。
+	template <typename T>
+	[[nodiscard]] std::uint64_t GetStableTypeHash() noexcept {
+		std::uint64_t hash = 0xcbf29ce484222325ull;
+		for (const char c : boost::typeindex::type_id<T>().pretty_name()) {
+			hash ^= static_cast<std::uint8_t>(c);
+			hash *= 0x100000001b3ull;
+		}
+		hash ^= sizeof(T);
+		hash *= 0x100000001b3ull;
+		return hash;
+	}
+
+	/// @brief 跨进程的三重物品缓冲池，用于在两个进程中无阻塞地存取较新的数据。
+	///	@details
+	///		接口与 @c TripleItemPool 一致，但需要先调用 @c Create 或 @c Attach 打开共享内存。
+	///		物品以字节的形式跨进程传递，所以只接受可平凡复制的类型，并且不能包含指针。
+	///	@tparam TItem 数据池中存储的物品的类型
+	template <typename TItem>
+		requires std::default_initializable<TItem> && std::is_trivially_copyable_v<TItem>
+	class SharedTripleItemPool final {
+		SharedTripleByteBuffer Buffer{};
+
+	public:
+		using ItemType = TItem;
+
+		/// @brief 创建共享内存，通常由生命周期较长的一端调用
+		[[nodiscard]] bool Create(spdlog::logger& logger, const std::string_view name) noexcept {
+			return Buffer.Create(logger, name, sizeof(TItem), GetStableTypeHash<TItem>());
+		}
+
+		[[nodiscard]] bool Create(const std::string_view name) noexcept {
+			return Create(*spdlog::default_logger(), name);
+		}
+
+		/// @brief 附加到已经存在的共享内存
+		[[nodiscard]] bool Attach(spdlog::logger& logger, const std::string_view name) noexcept {
+			return Buffer.Attach(logger, name, sizeof(TItem), GetStableTypeHash<TItem>());
+		}
+
+		[[nodiscard]] bool Attach(const std::string_view name) noexcept {
+			return Attach(*spdlog::default_logger(), name);
+		}
+
+		void Close() noexcept { Buffer.Close(); }
+
+		[[nodiscard]] bool IsOpen() const noexcept { return Buffer.IsOpen(); }
+
+		/// @brief 回收被已经退出的进程占用的槽位
+		std::size_t RecoverAbandonedSlots() noexcept { return Buffer.RecoverAbandonedSlots(); }
+
+		/// @brief 向数据池中写入数据，不阻塞当前线程
+		void SetItem(const TItem& item) noexcept { Buffer.WriteBytes(&item); }
+
+		/// @brief 从数据池中获取数据，不阻塞当前线程。在没有找到任何准备好的物品时，操作将会失败
+		[[nodiscard]] bool GetItem(TItem& item) noexcept { return Buffer.ReadBytes(&item); }
+	};
+}
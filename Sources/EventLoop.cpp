@@ -0,0 +1,191 @@
+#include <Cango/CommonUtils/EventLoop.hpp>
+#include <algorithm>
+#include <array>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include "InternalDetails.hpp"
+
+namespace {
+	using Cango::InternalDetails::GetErrorMessage;
+
+	timespec ToTimespec(const Cango::EventLoop::ClockType::time_point& time) noexcept {
+		const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+		return {
+			static_cast<time_t>(nanoseconds / 1'000'000'000),
+			static_cast<long>(nanoseconds % 1'000'000'000)
+		};
+	}
+}
+
+namespace Cango :: inline CommonUtils {
+	EventLoop::~EventLoop() noexcept {
+		for (const auto task : Tasks) task.destroy();
+		Close();
+	}
+
+	void EventLoop::Close() noexcept {
+		for (const int fd : {TimerFD, WakeFD, EpollFD}) if (fd != -1) ::close(fd);
+		TimerFD = WakeFD = EpollFD = -1;
+	}
+
+	bool EventLoop::Initialize(spdlog::logger& logger) noexcept {
+		Close();
+
+		EpollFD = ::epoll_create1(EPOLL_CLOEXEC);
+		if (EpollFD == -1) {
+			logger.error("EventLoop> 无法创建 epoll: {}", GetErrorMessage());
+			return false;
+		}
+
+		TimerFD = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		if (TimerFD == -1) {
+			logger.error("EventLoop> 无法创建 timerfd: {}", GetErrorMessage());
+			Close();
+			return false;
+		}
+
+		WakeFD = CreateNotifier(logger);
+		if (WakeFD == -1) {
+			Close();
+			return false;
+		}
+
+		// timerfd 和 eventfd 使用成员的地址区分，监视者使用自身的地址
+		epoll_event timer_event{EPOLLIN | EPOLLET, {.ptr = &TimerFD}};
+		epoll_event wake_event{EPOLLIN | EPOLLET, {.ptr = &WakeFD}};
+		if (::epoll_ctl(EpollFD, EPOLL_CTL_ADD, TimerFD, &timer_event) == -1 ||
+			::epoll_ctl(EpollFD, EPOLL_CTL_ADD, WakeFD, &wake_event) == -1) {
+			logger.error("EventLoop> 无法注册 timerfd 和 eventfd: {}", GetErrorMessage());
+			Close();
+			return false;
+		}
+
+		ArmedDeadline = ClockType::time_point::max();
+		return true;
+	}
+
+	void EventLoop::Spawn(LoopTask task) noexcept {
+		const auto handle = task.Release();
+		Tasks.push_back(handle);
+		ReadyList.push_back(handle);
+	}
+
+	void EventLoop::ScheduleAt(const ClockType::time_point deadline, const std::coroutine_handle<> handle) noexcept {
+		Timers.push({deadline, handle});
+	}
+
+	bool EventLoop::Watch(spdlog::logger& logger, const int fd, EventLoopWatcher& watcher) noexcept {
+		epoll_event event{EPOLLIN | EPOLLET, {.ptr = &watcher}};
+		if (::epoll_ctl(EpollFD, EPOLL_CTL_ADD, fd, &event) == 0) return true;
+		logger.error("EventLoop> 无法监视文件描述符({}): {}", fd, GetErrorMessage());
+		return false;
+	}
+
+	void EventLoop::Unwatch(const int fd) noexcept {
+		if (EpollFD != -1) ::epoll_ctl(EpollFD, EPOLL_CTL_DEL, fd, nullptr);
+	}
+
+	int EventLoop::CreateNotifier(spdlog::logger& logger) noexcept {
+		const int fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (fd == -1) logger.error("EventLoop> 无法创建 eventfd: {}", GetErrorMessage());
+		return fd;
+	}
+
+	void EventLoop::Notify(const int fd) noexcept {
+		constexpr std::uint64_t one = 1;
+		[[maybe_unused]] const auto result = ::write(fd, &one, sizeof(one));
+	}
+
+	std::uint64_t EventLoop::Drain(const int fd) noexcept {
+		std::uint64_t count = 0;
+		if (::read(fd, &count, sizeof(count)) != sizeof(count)) return 0;
+		return count;
+	}
+
+	void EventLoop::CloseNotifier(const int fd) noexcept { ::close(fd); }
+
+	void EventLoop::Stop() noexcept {
+		IsStopRequested.store(true, std::memory_order_relaxed);
+		Notify(WakeFD);
+	}
+
+	void EventLoop::ArmTimer() noexcept {
+		const auto deadline = Timers.empty() ? ClockType::time_point::max() : Timers.top().Deadline;
+		if (deadline == ArmedDeadline) return;
+		ArmedDeadline = deadline;
+
+		// 全零的时间会解除 timerfd ，所以已经过去的时间点至少设置为 1ns
+		itimerspec spec{};
+		if (deadline != ClockType::time_point::max()) {
+			spec.it_value = ToTimespec(deadline);
+			if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) spec.it_value.tv_nsec = 1;
+		}
+		::timerfd_settime(TimerFD, TFD_TIMER_ABSTIME, &spec, nullptr);
+	}
+
+	void EventLoop::ExpireTimers() noexcept {
+		const auto now = ClockType::now();
+		while (!Timers.empty() && Timers.top().Deadline <= now) {
+			ReadyList.push_back(Timers.top().Handle);
+			Timers.pop();
+		}
+		// timerfd 已经触发，需要重新设置
+		ArmedDeadline = ClockType::time_point::min();
+	}
+
+	void EventLoop::ResumeReady() noexcept {
+		RunningList.swap(ReadyList);
+		for (const auto handle : RunningList) {
+			handle.resume();
+			if (!handle.done()) continue;
+
+			// 只有任务本身会执行到结束，任务不能被其他协程等待
+			const auto task = std::ranges::find(Tasks, handle.address(), &LoopTask::HandleType::address);
+			if (task == Tasks.end()) continue;
+			task->destroy();
+			Tasks.erase(task);
+		}
+		RunningList.clear();
+	}
+
+	void EventLoop::Run() noexcept {
+		LoopThread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+		std::array<epoll_event, 64> events{};
+
+		// 还有就绪的协程时，每隔若干轮才检查一次文件描述符，避免每次切换都进行系统调用
+		constexpr std::size_t poll_interval = 64;
+		std::size_t ready_round = 0;
+
+		while (!IsStopRequested.load(std::memory_order_relaxed) && !Tasks.empty()) {
+			ResumeReady();
+			if (IsStopRequested.load(std::memory_order_relaxed) || Tasks.empty()) break;
+
+			const bool has_ready = !ReadyList.empty();
+			if (has_ready && ++ready_round % poll_interval != 0) {
+				if (!Timers.empty() && Timers.top().Deadline <= ClockType::now()) ExpireTimers();
+				continue;
+			}
+
+			ArmTimer();
+			const int timeout = has_ready ? 0 : -1;
+			const int count = ::epoll_wait(EpollFD, events.data(), static_cast<int>(events.size()), timeout);
+			for (int index = 0; index < count; ++index) {
+				void* pointer = events[index].data.ptr;
+				if (pointer == &TimerFD) {
+					Drain(TimerFD);
+					ExpireTimers();
+				}
+				else if (pointer == &WakeFD) Drain(WakeFD);
+				else static_cast<EventLoopWatcher*>(pointer)->OnReadable();
+			}
+
+			// timerfd 的事件可能和已经到期的定时任务不同步，已经到期的任务直接调度
+			if (!Timers.empty() && Timers.top().Deadline <= ClockType::now()) ExpireTimers();
+		}
+
+		IsStopRequested.store(false, std::memory_order_relaxed);
+		LoopThread.store({}, std::memory_order_relaxed);
+	}
+}
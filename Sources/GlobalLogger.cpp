@@ -1,28 +1,29 @@
 #include <Cango/CommonUtils/GlobalLogger.hpp>
+#include <Cango/CommonUtils/MappedFileSink.hpp>
 #include <ctime>
 #include <iostream>
-#include <spdlog/sinks/rotating_file_sink.h>
 #include <sstream>
 
 namespace Cango:: inline CommonUtils {
 	/// @brief 初始化默认日志记录器
-	/// 该日志记录器会同时输出到文件和控制台，并在文件达到指定大小时自动滚动
-	///	@param filename 日志文件名
+	/// 该日志记录器会同时输出到文件和控制台，文件是预先分配的内存映射分段，写满时切换到预先创建的下一个分段
+	///	@param filename 日志文件名，分段保存在 filename + 五位序号 + ".log"
 	///	@param level 日志记录器的最低日志等级，低于此等级的日志将不会被记录
 	[[nodiscard]] bool InitializeDefaultLogger(
 		const std::string_view filename,
 		const spdlog::level::level_enum level) noexcept {
-		static auto make_file_sink = [](const std::string_view file) {
-			constexpr std::size_t mb = 1024ull * 1024;
-			constexpr std::size_t file_size = 5 * mb;
-			constexpr std::size_t file_count = 0xffff;
-			return std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
-				std::string{file}, file_size, file_count, true);
-		};
+		constexpr std::size_t mb = 1024ull * 1024;
+		constexpr std::size_t segment_size = 5 * mb;
 
 		try {
+			const auto sink = std::make_shared<MappedFileSinkMT>();
+			if (!sink->Open({std::string{filename}, segment_size, false})) {
+				std::cerr << "无法初始化通用日志：无法打开日志文件 " << filename << '\n';
+				return false;
+			}
+
 			spdlog::default_logger()->set_level(level);
-			spdlog::default_logger()->sinks().emplace_back(make_file_sink(filename));
+			spdlog::default_logger()->sinks().emplace_back(sink);
 			return true;
 		}
 		catch (const std::exception& ex) {
@@ -36,8 +37,8 @@ namespace Cango:: inline CommonUtils {
 	}
 
 	/// @brief 初始化全局日志记录器
-	/// 该日志记录器会同时输出到文件和控制台，并在文件达到指定大小时自动滚动
-	///	@param appName 输出的文件将会保存在 logs/appName_年-月-日_时-分-秒-[.%d]
+	/// 该日志记录器会同时输出到文件和控制台，并在文件达到指定大小时切换到下一个分段
+	///	@param appName 输出的文件将会保存在 logs/appName_年-月-日_时-分-秒_序号.log
 	///	@return 是否初始化成功，错误消息将会输出到 std::err
 	[[nodiscard]] bool InitializeGlobalLogger(std::string_view appName) noexcept {
 		const std::time_t current_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <fmt/format.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// 源文件之间共享的辅助函数，不属于公开的接口
+namespace Cango::InternalDetails {
+	/// @brief 获取当前 errno 对应的错误信息
+	inline std::string GetErrorMessage() noexcept {
+		return std::error_code{errno, std::system_category()}.message();
+	}
+
+	constexpr std::size_t CacheLineSize = 64;
+
+	constexpr std::size_t AlignToCacheLine(const std::size_t size) noexcept {
+		return (size + CacheLineSize - 1) / CacheLineSize * CacheLineSize;
+	}
+
+	/// @brief 初始化映射文件中记录物品信息的头部
+	///	@tparam THeader 带有 Magic Version ItemSize TypeHash 以及 MagicValue CurrentVersion 的头部
+	template <typename THeader>
+	void InitializeItemHeader(THeader& header, const std::size_t itemSize, const std::uint64_t typeHash) noexcept {
+		header.Magic = THeader::MagicValue;
+		header.Version = THeader::CurrentVersion;
+		header.ItemSize = itemSize;
+		header.TypeHash = typeHash;
+	}
+
+	/// @brief 检查映射文件的头部是否与给定的物品大小和类型哈希一致
+	///	@return 不一致的原因，一致时为空
+	template <typename THeader>
+	[[nodiscard]] std::string_view CheckItemHeader(
+		const THeader& header,
+		const std::size_t itemSize,
+		const std::uint64_t typeHash) noexcept {
+		if (header.Magic != THeader::MagicValue) return "头部标识不匹配";
+		if (header.Version != THeader::CurrentVersion) return "版本不匹配";
+		if (header.ItemSize != itemSize) return "物品大小不匹配";
+		if (header.TypeHash != typeHash) return "物品类型不匹配";
+		return {};
+	}
+
+	/// @brief 以 MAP_SHARED 映射已经打开的文件的全部内容，文件小于 @c minimumSize 时失败
+	///	@return 映射的地址，失败时为 nullptr ，并在 @c error 中写入原因
+	[[nodiscard]] inline void* MapWholeFile(
+		const int fd,
+		const std::size_t minimumSize,
+		const int protection,
+		std::size_t& mappedSize,
+		std::string& error) noexcept try {
+		struct stat info{};
+		if (::fstat(fd, &info) == -1) {
+			error = fmt::format("无法获取文件大小: {}", GetErrorMessage());
+			return nullptr;
+		}
+
+		const auto size = static_cast<std::size_t>(info.st_size);
+		if (size < minimumSize || size == 0) {
+			error = fmt::format("文件大小({})小于需要的大小({})", size, minimumSize);
+			return nullptr;
+		}
+
+		void* address = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+		if (address == MAP_FAILED) {
+			error = GetErrorMessage();
+			return nullptr;
+		}
+		mappedSize = size;
+		return address;
+	}
+	catch (...) {
+		return nullptr;
+	}
+
+	/// @brief 创建新的共享内存并映射，同名的共享内存已经存在时失败
+	///	@details 设置大小或者映射失败时删除刚刚创建的名称，不会留下长度为零的共享内存。
+	///	@return 映射的地址，失败时为 nullptr ，并在 @c error 中写入原因
+	[[nodiscard]] inline void* CreateSharedMemory(
+		const std::string& name,
+		const std::size_t size,
+		const mode_t mode,
+		std::size_t& mappedSize,
+		std::string& error) noexcept try {
+		const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, mode);
+		if (fd == -1) {
+			error = GetErrorMessage();
+			return nullptr;
+		}
+
+		if (::ftruncate(fd, static_cast<off_t>(size)) == -1) {
+			error = fmt::format("无法设置大小: {}", GetErrorMessage());
+			::close(fd);
+			::shm_unlink(name.c_str());
+			return nullptr;
+		}
+
+		void* address = MapWholeFile(fd, size, PROT_READ | PROT_WRITE, mappedSize, error);
+		::close(fd);
+		if (address == nullptr) ::shm_unlink(name.c_str());
+		return address;
+	}
+	catch (...) {
+		::shm_unlink(name.c_str());
+		return nullptr;
+	}
+
+	/// @brief 打开已经存在的共享内存并映射全部内容，共享内存小于 @c minimumSize 时失败
+	///	@param protection PROT_READ 时以只读的方式打开，否则以读写的方式打开
+	///	@return 映射的地址，失败时为 nullptr ，并在 @c error 中写入原因
+	[[nodiscard]] inline void* OpenSharedMemory(
+		const std::string& name,
+		const std::size_t minimumSize,
+		const int protection,
+		std::size_t& mappedSize,
+		std::string& error) noexcept {
+		const int fd = ::shm_open(name.c_str(), protection == PROT_READ ? O_RDONLY : O_RDWR, 0);
+		if (fd == -1) {
+			error = GetErrorMessage();
+			return nullptr;
+		}
+
+		void* address = MapWholeFile(fd, minimumSize, protection, mappedSize, error);
+		::close(fd);
+		return address;
+	}
+
+	/// @brief 删除共享内存的名称，名称不存在时视为成功
+	///	@return 是否成功，失败时在 @c error 中写入原因
+	[[nodiscard]] inline bool RemoveSharedMemory(const std::string_view name, std::string& error) noexcept try {
+		if (::shm_unlink(std::string{name}.c_str()) == 0 || errno == ENOENT) return true;
+		error = GetErrorMessage();
+		return false;
+	}
+	catch (...) {
+		return false;
+	}
+}
@@ -0,0 +1,118 @@
+#include <Cango/CommonUtils/ItemPoolCapture.hpp>
+#include <cerrno>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "InternalDetails.hpp"
+
+namespace {
+	using namespace Cango::InternalDetails;
+	using Header = Cango::ItemPoolCaptureHeader;
+	using Record = Cango::ItemPoolCaptureRecord;
+
+	constexpr std::size_t RecordsOffset = AlignToCacheLine(sizeof(Header));
+}
+
+namespace Cango :: inline CommonUtils {
+	ItemPoolCaptureFile::~ItemPoolCaptureFile() noexcept { Close(); }
+
+	ItemPoolCaptureRecord* ItemPoolCaptureFile::GetRecord(const std::uint64_t slot) const noexcept {
+		return reinterpret_cast<ItemPoolCaptureRecord*>(Records + slot * Header->RecordStride);
+	}
+
+	bool ItemPoolCaptureFile::Create(
+		spdlog::logger& logger,
+		const FilePathType& file,
+		const std::size_t itemSize,
+		const std::uint64_t typeHash,
+		const std::size_t capacity) noexcept {
+		Close();
+		PathString = file.string();
+
+		if (capacity == 0) {
+			logger.error("ItemPoolCaptureFile> 捕获文件({})的容量不能为零", PathString);
+			return false;
+		}
+
+		const int fd = ::open(PathString.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+		if (fd == -1) {
+			logger.error("ItemPoolCaptureFile> 无法创建捕获文件({}): {}", PathString, GetErrorMessage());
+			return false;
+		}
+
+		const auto stride = AlignToCacheLine(sizeof(Record) + itemSize);
+		const auto size = RecordsOffset + stride * capacity;
+
+		// 预先分配磁盘空间，避免在追加记录时因为磁盘空间不足收到 SIGBUS
+		if (const int result = ::posix_fallocate(fd, 0, static_cast<off_t>(size)); result != 0) {
+			errno = result;
+			logger.error("ItemPoolCaptureFile> 无法为捕获文件({})分配 {} 字节: {}", PathString, size, GetErrorMessage());
+			::close(fd);
+			return false;
+		}
+
+		std::string error{};
+		void* address = MapWholeFile(fd, size, PROT_READ | PROT_WRITE, MappedSize, error);
+		::close(fd);
+		if (address == nullptr) {
+			logger.error("ItemPoolCaptureFile> 无法映射捕获文件({}): {}", PathString, error);
+			return false;
+		}
+
+		Header = new(address) ItemPoolCaptureHeader{};
+		InitializeItemHeader(*Header, itemSize, typeHash);
+		Header->RecordStride = stride;
+		Header->Capacity = capacity;
+		Records = static_cast<std::uint8_t*>(address) + RecordsOffset;
+		Writable = true;
+		return true;
+	}
+
+	bool ItemPoolCaptureFile::Open(
+		spdlog::logger& logger,
+		const FilePathType& file,
+		const std::size_t itemSize,
+		const std::uint64_t typeHash) noexcept {
+		Close();
+		PathString = file.string();
+
+		const int fd = ::open(PathString.c_str(), O_RDONLY);
+		if (fd == -1) {
+			logger.error("ItemPoolCaptureFile> 无法打开捕获文件({}): {}", PathString, GetErrorMessage());
+			return false;
+		}
+
+		std::string error{};
+		void* address = MapWholeFile(fd, RecordsOffset, PROT_READ, MappedSize, error);
+		::close(fd);
+		if (address == nullptr) {
+			logger.error("ItemPoolCaptureFile> 无法映射捕获文件({}): {}", PathString, error);
+			return false;
+		}
+
+		Header = static_cast<ItemPoolCaptureHeader*>(address);
+		Records = static_cast<std::uint8_t*>(address) + RecordsOffset;
+		Writable = false;
+
+		const auto fail = [this, &logger](const std::string_view reason) noexcept {
+			logger.error("ItemPoolCaptureFile> 无法读取捕获文件({}): {}", PathString, reason);
+			Close();
+			return false;
+		};
+
+		if (const auto reason = CheckItemHeader(*Header, itemSize, typeHash); !reason.empty()) return fail(reason);
+		if (Header->Capacity == 0 || RecordsOffset + Header->RecordStride * Header->Capacity > MappedSize)
+			return fail("文件大小与记录容量不匹配");
+		return true;
+	}
+
+	void ItemPoolCaptureFile::Close() noexcept {
+		if (Header == nullptr) return;
+		::munmap(Header, MappedSize);
+		Header = nullptr;
+		Records = nullptr;
+		MappedSize = 0;
+		Writable = false;
+	}
+}
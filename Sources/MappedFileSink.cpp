@@ -0,0 +1,297 @@
+#include <Cango/CommonUtils/MappedFileSink.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <system_error>
+#include <utility>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "InternalDetails.hpp"
+
+#ifdef CANGO_COMMON_UTILS_ENABLE_LOG_COMPRESSION
+#include <zlib.h>
+#endif
+
+namespace {
+	using Cango::InternalDetails::GetErrorMessage;
+
+	std::size_t AlignToPage(const std::size_t size) noexcept {
+		const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+		return std::max(page_size, (size + page_size - 1) / page_size * page_size);
+	}
+}
+
+namespace Cango :: inline CommonUtils {
+	MappedLogFile::~MappedLogFile() noexcept { Close(); }
+
+	std::string MappedLogFile::GetSegmentPath(const std::uint64_t index) const {
+		return fmt::format("{}{:0>5}.log", Config.BaseName, index);
+	}
+
+	std::uint64_t MappedLogFile::FindNextIndex() const {
+		const boost::filesystem::path base{Config.BaseName};
+		const auto prefix = base.filename().string();
+		auto directory = base.parent_path();
+		if (directory.empty()) directory = ".";
+
+		std::uint64_t next_index = 0;
+		boost::system::error_code result{};
+		for (boost::filesystem::directory_iterator it{directory, result}, end{}; !result && it != end; it.increment(result)) {
+			const auto name = it->path().filename().string();
+			if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) continue;
+
+			// 文件名为 前缀 + 序号 + ".log" 或者 ".log.gz"
+			const std::string_view rest{name.data() + prefix.size(), name.size() - prefix.size()};
+			const auto digit_count = rest.find_first_not_of("0123456789");
+			if (digit_count == 0 || digit_count == std::string_view::npos) continue;
+			if (const auto suffix = rest.substr(digit_count); suffix != ".log" && suffix != ".log.gz") continue;
+
+			std::uint64_t index = 0;
+			if (std::from_chars(rest.data(), rest.data() + digit_count, index).ec != std::errc{}) continue;
+			next_index = std::max(next_index, index + 1);
+		}
+		return next_index;
+	}
+
+	bool MappedLogFile::CreateSegment(std::uint64_t& index, Segment& segment, std::string& error) const noexcept {
+		// 不覆盖已经存在的文件，例如其他进程使用相同的名称写入的分段
+		std::string path{};
+		int fd = -1;
+		for (;; ++index) {
+			path = GetSegmentPath(index);
+			fd = ::open(path.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644);
+			if (fd != -1 || errno != EEXIST) break;
+		}
+		if (fd == -1) {
+			error = fmt::format("无法创建日志分段({}): {}", path, GetErrorMessage());
+			return false;
+		}
+
+		// 预先分配磁盘空间，避免在追加日志时因为磁盘空间不足收到 SIGBUS
+		if (const int result = ::posix_fallocate(fd, 0, static_cast<off_t>(SegmentSize)); result != 0) {
+			errno = result;
+			error = fmt::format("无法为日志分段({})分配 {} 字节: {}", path, SegmentSize, GetErrorMessage());
+			::close(fd);
+			::unlink(path.c_str());
+			return false;
+		}
+
+		// 预先填充页表，追加日志时不会触发缺页
+		void* address = ::mmap(nullptr, SegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+		if (address == MAP_FAILED) {
+			error = fmt::format("无法映射日志分段({}): {}", path, GetErrorMessage());
+			::close(fd);
+			::unlink(path.c_str());
+			return false;
+		}
+
+		segment = {path, fd, static_cast<char*>(address), 0};
+		return true;
+	}
+
+	bool MappedLogFile::CompressSegment(const Segment& segment) noexcept {
+#ifdef CANGO_COMMON_UTILS_ENABLE_LOG_COMPRESSION
+		const auto path = segment.Path + ".gz";
+		const gzFile file = ::gzopen(path.c_str(), "wb1");
+		if (file == nullptr) {
+			std::cerr << "MappedLogFile> 无法创建压缩文件(" << path << ")\n";
+			return false;
+		}
+
+		bool is_succeeded = true;
+		for (std::size_t offset = 0; offset < segment.Used && is_succeeded;) {
+			const auto size = static_cast<unsigned>(std::min<std::size_t>(segment.Used - offset, INT_MAX));
+			is_succeeded = ::gzwrite(file, segment.Data + offset, size) == static_cast<int>(size);
+			offset += size;
+		}
+		is_succeeded = ::gzclose(file) == Z_OK && is_succeeded;
+
+		if (!is_succeeded) {
+			std::cerr << "MappedLogFile> 无法压缩日志分段(" << segment.Path << ")\n";
+			::unlink(path.c_str());
+		}
+		return is_succeeded;
+#else
+		// 没有启用压缩时 Open 拒绝压缩的配置，不会执行到这里
+		static_cast<void>(segment);
+		return false;
+#endif
+	}
+
+	void MappedLogFile::FinishSegment(Segment& segment) const noexcept {
+		if (Config.CompressClosedSegments && CompressSegment(segment)) {
+			RemoveSegment(segment);
+			return;
+		}
+
+		::munmap(segment.Data, SegmentSize);
+		if (::ftruncate(segment.FD, static_cast<off_t>(segment.Used)) == -1)
+			std::cerr << "MappedLogFile> 无法截断日志分段(" << segment.Path << "): " << GetErrorMessage() << '\n';
+		::close(segment.FD);
+		segment = {};
+	}
+
+	void MappedLogFile::RemoveSegment(Segment& segment) const noexcept {
+		::munmap(segment.Data, SegmentSize);
+		::close(segment.FD);
+		::unlink(segment.Path.c_str());
+		segment = {};
+	}
+
+	void MappedLogFile::RequestPrepare() noexcept {
+		PrepareIndex = NextIndex;
+		IsPrepareRequested = true;
+		IsPreparing = true;
+		WorkerCondition.notify_all();
+	}
+
+	bool MappedLogFile::Rotate() noexcept {
+		std::unique_lock lock{WorkerMutex};
+
+		const bool was_writing = Current.Data != nullptr;
+		if (was_writing) {
+			ClosedSegments.push_back(std::exchange(Current, {}));
+			WorkerCondition.notify_all();
+			// 下一个分段还没有创建完成时在这里阻塞日志线程，见类的说明；之前已经失败时不阻塞
+			WorkerCondition.wait(lock, [this] { return !IsPreparing; });
+		}
+		if (IsPreparing) return false;
+
+		if (Prepared.Data == nullptr) {
+			RequestPrepare();
+			return false;
+		}
+
+		Current = std::exchange(Prepared, {});
+		NextIndex = PrepareIndex + 1;
+		RequestPrepare();
+		return true;
+	}
+
+	void MappedLogFile::RunWorker() noexcept {
+		std::unique_lock lock{WorkerMutex};
+		while (true) {
+			WorkerCondition.wait(lock, [this] { return IsStopRequested || IsPrepareRequested || !ClosedSegments.empty(); });
+
+			if (IsPrepareRequested && !IsStopRequested) {
+				IsPrepareRequested = false;
+				auto index = PrepareIndex;
+				lock.unlock();
+
+				Segment segment{};
+				std::string error{};
+				if (!CreateSegment(index, segment, error)) std::cerr << "MappedLogFile> " << error << '\n';
+
+				lock.lock();
+				Prepared = std::move(segment);
+				PrepareIndex = index;
+				IsPreparing = false;
+				WorkerCondition.notify_all();
+				continue;
+			}
+
+			if (!ClosedSegments.empty()) {
+				auto closed_segments = std::exchange(ClosedSegments, {});
+				lock.unlock();
+				for (auto& segment : closed_segments) FinishSegment(segment);
+				lock.lock();
+				continue;
+			}
+
+			if (IsStopRequested) return;
+		}
+	}
+
+	bool MappedLogFile::Open(spdlog::logger& logger, Configuration config) noexcept {
+		Close();
+
+		if (config.BaseName.empty()) {
+			logger.error("MappedLogFile> 日志文件的名称不能为空");
+			return false;
+		}
+
+#ifndef CANGO_COMMON_UTILS_ENABLE_LOG_COMPRESSION
+		if (config.CompressClosedSegments) {
+			logger.error("MappedLogFile> 编译时没有启用日志压缩(Cango_CommonUtils_EnableLogCompression)，无法压缩关闭的分段");
+			return false;
+		}
+#endif
+
+		Config = std::move(config);
+		SegmentSize = AlignToPage(Config.SegmentSize);
+		DroppedCount = 0;
+
+		const auto directory = boost::filesystem::path{Config.BaseName}.parent_path();
+		if (boost::system::error_code result{}; !directory.empty() && !boost::filesystem::create_directories(directory, result) && result) {
+			logger.error("MappedLogFile> 无法创建日志目录({}): {}", directory.string(), result.message());
+			return false;
+		}
+
+		try {
+			NextIndex = FindNextIndex();
+		}
+		catch (const std::exception& error) {
+			logger.error("MappedLogFile> 无法查找已经存在的日志分段: {}", error.what());
+			return false;
+		}
+
+		if (std::string error{}; !CreateSegment(NextIndex, Current, error)) {
+			logger.error("MappedLogFile> {}", error);
+			return false;
+		}
+		++NextIndex;
+
+		IsStopRequested = false;
+		RequestPrepare();
+		try {
+			Worker = std::thread{[this] { RunWorker(); }};
+		}
+		catch (const std::system_error& error) {
+			logger.error("MappedLogFile> 无法启动后台线程: {}", error.what());
+			IsPrepareRequested = IsPreparing = false;
+			RemoveSegment(Current);
+			return false;
+		}
+
+		IsOpened = true;
+		return true;
+	}
+
+	void MappedLogFile::Close() noexcept {
+		if (!IsOpened) return;
+
+		{
+			std::lock_guard lock{WorkerMutex};
+			if (Current.Data != nullptr) ClosedSegments.push_back(std::exchange(Current, {}));
+			IsStopRequested = true;
+		}
+		WorkerCondition.notify_all();
+		Worker.join();
+
+		// 后台线程退出前已经处理完所有关闭的分段，只剩下预先创建但没有使用的分段
+		if (Prepared.Data != nullptr) RemoveSegment(Prepared);
+		IsPrepareRequested = IsPreparing = IsStopRequested = false;
+		IsOpened = false;
+	}
+
+	void MappedLogFile::Append(std::string_view text) noexcept {
+		if (!IsOpened) return;
+
+		if (text.size() > SegmentSize) text = text.substr(0, SegmentSize);
+		if (Current.Data == nullptr || Current.Used + text.size() > SegmentSize) {
+			if (!Rotate()) {
+				++DroppedCount;
+				return;
+			}
+		}
+
+		std::memcpy(Current.Data + Current.Used, text.data(), text.size());
+		Current.Used += text.size();
+	}
+}
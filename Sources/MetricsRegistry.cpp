@@ -0,0 +1,325 @@
+#include <Cango/CommonUtils/MetricsRegistry.hpp>
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <new>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <sys/mman.h>
+#include "InternalDetails.hpp"
+
+namespace {
+	using namespace Cango;
+
+	std::string_view GetName(const std::array<char, MetricSlot::MaxNameLength + 1>& name) noexcept {
+		return {name.data()};
+	}
+
+	/// Prometheus 的指标名称只允许字母、数字、下划线和冒号
+	std::string ToPrometheusName(const std::string_view name) {
+		std::string result{name};
+		std::ranges::replace_if(result, [](const char c) {
+			return !(std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == ':');
+		}, '_');
+		if (!result.empty() && std::isdigit(static_cast<unsigned char>(result.front()))) result.insert(0, 1, '_');
+		return result;
+	}
+
+	void AppendPrometheusEntry(std::string& text, const MetricSnapshotEntry& entry) {
+		const auto name = ToPrometheusName(GetName(entry.Name));
+		auto out = std::back_inserter(text);
+		switch (entry.Kind) {
+		case MetricKind::Counter:
+			fmt::format_to(out, "# TYPE {0} counter\n{0} {1}\n", name, entry.Count);
+			break;
+		case MetricKind::Rate:
+			fmt::format_to(out, "# TYPE {0}_total counter\n{0}_total {1}\n", name, entry.Count);
+			fmt::format_to(out, "# TYPE {0} gauge\n{0} {1}\n", name, entry.Value);
+			break;
+		case MetricKind::Gauge:
+			fmt::format_to(out, "# TYPE {0} gauge\n{0} {1}\n", name, entry.Value);
+			break;
+		case MetricKind::Histogram: {
+			fmt::format_to(out, "# TYPE {} histogram\n", name);
+			const auto last = std::ranges::find_if(entry.Buckets.rbegin(), entry.Buckets.rend(),
+				[](const std::uint64_t count) { return count != 0; });
+			const auto used = static_cast<std::size_t>(std::distance(last, entry.Buckets.rend()));
+			std::uint64_t cumulative = 0;
+			for (std::size_t index = 0; index < used && index < MetricSlot::BucketCount - 1; ++index) {
+				cumulative += entry.Buckets[index];
+				const auto upper = index == 0 ? 0 : (std::uint64_t{1} << index) - 1;
+				fmt::format_to(out, "{}_bucket{{le=\"{}\"}} {}\n", name, upper, cumulative);
+			}
+			fmt::format_to(out, "{0}_bucket{{le=\"+Inf\"}} {1}\n{0}_sum {2}\n{0}_count {1}\n", name, entry.Count, entry.Sum);
+			break;
+		}
+		}
+	}
+}
+
+namespace Cango :: inline CommonUtils {
+	MetricsRegistry& MetricsRegistry::Instance() noexcept {
+		static MetricsRegistry registry{};
+		return registry;
+	}
+
+	MetricSlot& MetricsRegistry::Register(spdlog::logger& logger, const std::string_view name, const MetricKind kind) noexcept {
+		if (name.empty() || name.size() > MetricSlot::MaxNameLength) {
+			logger.error("MetricsRegistry> 指标名称({})的长度必须在 1 到 {} 之间", name, MetricSlot::MaxNameLength);
+			return DiscardedSlot;
+		}
+
+		std::lock_guard lock{RegisterMutex};
+		const auto count = Count.load(std::memory_order_relaxed);
+		for (std::size_t index = 0; index < count; ++index) {
+			auto& slot = Slots[index];
+			if (GetName(slot.Name) != name) continue;
+			if (slot.Kind == kind) return slot;
+			logger.error("MetricsRegistry> 指标({})已经以其他种类注册", name);
+			return DiscardedSlot;
+		}
+
+		if (count >= MaxMetricCount) {
+			logger.error("MetricsRegistry> 指标数量超出上限({})，无法注册指标({})", MaxMetricCount, name);
+			return DiscardedSlot;
+		}
+
+		auto& slot = Slots[count];
+		std::ranges::copy(name, slot.Name.begin());
+		slot.Kind = kind;
+		Count.store(count + 1, std::memory_order_release);
+		return slot;
+	}
+
+	MetricCounter MetricsRegistry::RegisterCounter(spdlog::logger& logger, const std::string_view name) noexcept {
+		return MetricCounter{Register(logger, name, MetricKind::Counter)};
+	}
+
+	MetricCounter MetricsRegistry::RegisterCounter(const std::string_view name) noexcept {
+		return RegisterCounter(*spdlog::default_logger(), name);
+	}
+
+	MetricRate MetricsRegistry::RegisterRate(spdlog::logger& logger, const std::string_view name) noexcept {
+		return MetricRate{Register(logger, name, MetricKind::Rate)};
+	}
+
+	MetricRate MetricsRegistry::RegisterRate(const std::string_view name) noexcept {
+		return RegisterRate(*spdlog::default_logger(), name);
+	}
+
+	MetricGauge MetricsRegistry::RegisterGauge(spdlog::logger& logger, const std::string_view name) noexcept {
+		return MetricGauge{Register(logger, name, MetricKind::Gauge)};
+	}
+
+	MetricGauge MetricsRegistry::RegisterGauge(const std::string_view name) noexcept {
+		return RegisterGauge(*spdlog::default_logger(), name);
+	}
+
+	MetricHistogram MetricsRegistry::RegisterHistogram(spdlog::logger& logger, const std::string_view name) noexcept {
+		return MetricHistogram{Register(logger, name, MetricKind::Histogram)};
+	}
+
+	MetricHistogram MetricsRegistry::RegisterHistogram(const std::string_view name) noexcept {
+		return RegisterHistogram(*spdlog::default_logger(), name);
+	}
+
+	bool ReadMetricsSnapshot(spdlog::logger& logger, const std::string_view name, MetricsSnapshot& snapshot) noexcept {
+		// 导出器崩溃时可能留下长度为零的共享内存，其他版本的快照大小也可能不同，映射前先检查大小
+		std::string error{};
+		std::size_t mapped_size = 0;
+		void* address = InternalDetails::OpenSharedMemory(std::string{name}, sizeof(MetricsSnapshot), PROT_READ, mapped_size, error);
+		if (address == nullptr) {
+			logger.error("ReadMetricsSnapshot> 无法映射共享内存({}): {}", name, error);
+			return false;
+		}
+
+		const auto& shared = *static_cast<const MetricsSnapshot*>(address);
+		if (shared.Magic != MetricsSnapshot::MagicValue || shared.Version != MetricsSnapshot::CurrentVersion) {
+			logger.error("ReadMetricsSnapshot> 共享内存({})的头部标识或版本不匹配", name);
+			::munmap(address, mapped_size);
+			return false;
+		}
+
+		bool is_consistent = false;
+		for (int attempt = 0; attempt < 100 && !is_consistent; ++attempt) {
+			const auto begin = shared.Sequence.load(std::memory_order_acquire);
+			if (begin % 2 != 0) {
+				std::this_thread::yield();
+				continue;
+			}
+			snapshot.Magic = shared.Magic;
+			snapshot.Version = shared.Version;
+			snapshot.Timestamp = shared.Timestamp;
+			snapshot.Count = shared.Count;
+			snapshot.Entries = shared.Entries;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			is_consistent = shared.Sequence.load(std::memory_order_relaxed) == begin;
+			snapshot.Sequence.store(begin, std::memory_order_relaxed);
+		}
+		::munmap(address, mapped_size);
+
+		if (!is_consistent) {
+			logger.error("ReadMetricsSnapshot> 共享内存({})中的快照一直在更新，无法读取完整的快照", name);
+			return false;
+		}
+		if (snapshot.Count > MetricsRegistry::MaxMetricCount) {
+			logger.error("ReadMetricsSnapshot> 共享内存({})中的指标数量({})超过上限({})", name, snapshot.Count, MetricsRegistry::MaxMetricCount);
+			return false;
+		}
+		return true;
+	}
+
+	MetricsExporter::~MetricsExporter() noexcept { Stop(); }
+
+	bool MetricsExporter::Remove(spdlog::logger& logger, const std::string_view name) noexcept {
+		if (std::string error{}; !InternalDetails::RemoveSharedMemory(name, error)) {
+			logger.error("MetricsExporter> 无法删除共享内存({}): {}", name, error);
+			return false;
+		}
+		return true;
+	}
+
+	bool MetricsExporter::Start(spdlog::logger& logger, Configuration config) noexcept try {
+		if (Worker.joinable()) {
+			logger.error("MetricsExporter> 导出器已经启动");
+			return false;
+		}
+
+		Config = std::move(config);
+		Logger = &logger;
+
+		if (!Config.SharedMemoryName.empty()) {
+			// 外部的监控工具可能以其他用户运行，所以共享内存对其他用户可读
+			const auto& name = Config.SharedMemoryName;
+			std::string error{};
+			std::size_t mapped_size = 0;
+			void* address = InternalDetails::CreateSharedMemory(name, sizeof(MetricsSnapshot), 0644, mapped_size, error);
+			if (address == nullptr) {
+				logger.error("MetricsExporter> 无法创建共享内存({}): {}", name, error);
+				return false;
+			}
+			Snapshot = new(address) MetricsSnapshot{};
+		}
+		else {
+			LocalSnapshot = std::make_unique<MetricsSnapshot>();
+			Snapshot = LocalSnapshot.get();
+		}
+		Snapshot->Magic = MetricsSnapshot::MagicValue;
+		Snapshot->Version = MetricsSnapshot::CurrentVersion;
+
+		LastCounts.fill(0);
+		LastExportTime = std::chrono::steady_clock::now();
+		IsStopRequested = false;
+		Worker = std::thread{[this] {
+			std::unique_lock lock{StopMutex};
+			while (!StopCondition.wait_for(lock, Config.Interval, [this] { return IsStopRequested; })) {
+				lock.unlock();
+				ExportOnce();
+				lock.lock();
+			}
+		}};
+		return true;
+	}
+	catch (const std::exception& ex) {
+		logger.error("MetricsExporter> 无法启动导出线程: {}", ex.what());
+		Release();
+		return false;
+	}
+
+	bool MetricsExporter::Start(Configuration config) noexcept {
+		return Start(*spdlog::default_logger(), std::move(config));
+	}
+
+	void MetricsExporter::Stop() noexcept {
+		if (Worker.joinable()) {
+			{
+				std::lock_guard lock{StopMutex};
+				IsStopRequested = true;
+			}
+			StopCondition.notify_all();
+			Worker.join();
+			ExportOnce();
+		}
+		Release();
+	}
+
+	void MetricsExporter::Release() noexcept {
+		if (Snapshot != nullptr && !LocalSnapshot) {
+			::munmap(Snapshot, sizeof(MetricsSnapshot));
+			::shm_unlink(Config.SharedMemoryName.c_str());
+		}
+		Snapshot = nullptr;
+		LocalSnapshot.reset();
+	}
+
+	void MetricsExporter::ExportOnce() noexcept {
+		const auto& registry = MetricsRegistry::Instance();
+		const auto now = std::chrono::steady_clock::now();
+		const auto seconds = std::chrono::duration<double>(now - LastExportTime).count();
+		LastExportTime = now;
+
+		const auto sequence = Snapshot->Sequence.load(std::memory_order_relaxed);
+		Snapshot->Sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		const auto count = registry.GetCount();
+		Snapshot->Timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+		Snapshot->Count = count;
+		for (std::size_t index = 0; index < count; ++index) {
+			const auto& slot = registry.GetSlot(index);
+			auto& entry = Snapshot->Entries[index];
+			entry.Name = slot.Name;
+			entry.Kind = slot.Kind;
+
+			const auto value = slot.Value.load(std::memory_order_relaxed);
+			switch (slot.Kind) {
+			case MetricKind::Counter:
+				entry.Count = value;
+				break;
+			case MetricKind::Rate:
+				entry.Count = value;
+				entry.Value = seconds > 0 ? static_cast<double>(value - LastCounts[index]) / seconds : 0;
+				LastCounts[index] = value;
+				break;
+			case MetricKind::Gauge:
+				entry.Value = std::bit_cast<double>(value);
+				break;
+			case MetricKind::Histogram:
+				entry.Count = value;
+				entry.Sum = slot.Sum.load(std::memory_order_relaxed);
+				for (std::size_t bucket = 0; bucket < MetricSlot::BucketCount; ++bucket)
+					entry.Buckets[bucket] = slot.Buckets[bucket].load(std::memory_order_relaxed);
+				break;
+			}
+		}
+
+		Snapshot->Sequence.store(sequence + 2, std::memory_order_release);
+
+		if (!Config.PrometheusFile.empty()) WritePrometheusFile();
+	}
+
+	void MetricsExporter::WritePrometheusFile() const noexcept try {
+		std::string text{};
+		for (std::size_t index = 0; index < Snapshot->Count; ++index)
+			AppendPrometheusEntry(text, Snapshot->Entries[index]);
+
+		// 先写入临时文件再重命名，读取方不会读到写了一半的文件
+		auto temporary = Config.PrometheusFile;
+		temporary += ".tmp";
+		{
+			boost::filesystem::ofstream stream{temporary, std::ios::out | std::ios::trunc};
+			if (!stream.is_open()) {
+				Logger->error("MetricsExporter> 无法打开文件({})", temporary.string());
+				return;
+			}
+			stream << text;
+		}
+
+		if (boost::system::error_code result{}; boost::filesystem::rename(temporary, Config.PrometheusFile, result), result.failed())
+			Logger->error("MetricsExporter> 无法写入文件({}): {}", Config.PrometheusFile.string(), result.message());
+	}
+	catch (const std::exception& ex) {
+		Logger->error("MetricsExporter> 无法写入文件({}): {}", Config.PrometheusFile.string(), ex.what());
+	}
+}
@@ -0,0 +1,172 @@
+#include <Cango/CommonUtils/SharedItemPool.hpp>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "InternalDetails.hpp"
+
+namespace {
+	using namespace Cango::InternalDetails;
+	using Header = Cango::SharedTripleByteBufferHeader;
+	using Protocol = TripleBufferSlotProtocol;
+
+	static_assert(Header::ItemCount == Protocol::ItemCount);
+
+	constexpr std::size_t ItemsOffset = AlignToCacheLine(sizeof(Header));
+
+	/// 检查进程是否已经退出，没有权限发送信号的进程视为存活
+	bool IsProcessDead(const std::uint64_t pid) noexcept {
+		return ::kill(static_cast<pid_t>(pid), 0) == -1 && errno == ESRCH;
+	}
+}
+
+namespace Cango :: inline CommonUtils {
+	SharedTripleByteBuffer::SharedTripleByteBuffer(SharedTripleByteBuffer&& other) noexcept :
+		Name(std::move(other.Name)),
+		Header(other.Header),
+		Items(other.Items),
+		MappedSize(other.MappedSize),
+		ProcessID(other.ProcessID),
+		IsCreator(other.IsCreator) {
+		other.Header = nullptr;
+		other.Items = nullptr;
+		other.MappedSize = 0;
+		other.IsCreator = false;
+	}
+
+	SharedTripleByteBuffer& SharedTripleByteBuffer::operator=(SharedTripleByteBuffer&& other) noexcept {
+		if (this == &other) return *this;
+		Close();
+		Name = std::move(other.Name);
+		Header = other.Header;
+		Items = other.Items;
+		MappedSize = other.MappedSize;
+		ProcessID = other.ProcessID;
+		IsCreator = other.IsCreator;
+		other.Header = nullptr;
+		other.Items = nullptr;
+		other.MappedSize = 0;
+		other.IsCreator = false;
+		return *this;
+	}
+
+	SharedTripleByteBuffer::~SharedTripleByteBuffer() noexcept { Close(); }
+
+	std::size_t SharedTripleByteBuffer::GetSegmentSize(const std::size_t itemSize) noexcept {
+		return ItemsOffset + AlignToCacheLine(itemSize) * Header::ItemCount;
+	}
+
+	bool SharedTripleByteBuffer::Remove(spdlog::logger& logger, const std::string_view name) noexcept {
+		if (std::string error{}; !RemoveSharedMemory(name, error)) {
+			logger.error("SharedTripleByteBuffer> 无法删除共享内存({}): {}", name, error);
+			return false;
+		}
+		return true;
+	}
+
+	void SharedTripleByteBuffer::SetMapping(void* address) noexcept {
+		Header = static_cast<SharedTripleByteBufferHeader*>(address);
+		Items = static_cast<std::uint8_t*>(address) + ItemsOffset;
+		ProcessID = static_cast<std::uint64_t>(::getpid());
+	}
+
+	bool SharedTripleByteBuffer::Create(
+		spdlog::logger& logger,
+		const std::string_view name,
+		const std::size_t itemSize,
+		const std::uint64_t typeHash) noexcept {
+		Close();
+		Name = name;
+
+		std::string error{};
+		void* address = CreateSharedMemory(Name, GetSegmentSize(itemSize), 0600, MappedSize, error);
+		if (address == nullptr) {
+			logger.error("SharedTripleByteBuffer> 无法创建共享内存({}): {}", Name, error);
+			return false;
+		}
+
+		SetMapping(address);
+		Header = new(Header) SharedTripleByteBufferHeader{};
+		InitializeItemHeader(*Header, itemSize, typeHash);
+		Header->ItemStride = AlignToCacheLine(itemSize);
+		Header->Ready.store(1, std::memory_order_release);
+		IsCreator = true;
+		return true;
+	}
+
+	bool SharedTripleByteBuffer::Attach(
+		spdlog::logger& logger,
+		const std::string_view name,
+		const std::size_t itemSize,
+		const std::uint64_t typeHash) noexcept {
+		Close();
+		Name = name;
+
+		std::string error{};
+		void* address = OpenSharedMemory(Name, GetSegmentSize(itemSize), PROT_READ | PROT_WRITE, MappedSize, error);
+		if (address == nullptr) {
+			logger.error("SharedTripleByteBuffer> 无法打开共享内存({}): {}", Name, error);
+			return false;
+		}
+		SetMapping(address);
+
+		const auto fail = [this, &logger](const std::string_view reason) noexcept {
+			logger.error("SharedTripleByteBuffer> 无法附加到共享内存({}): {}", Name, reason);
+			Close();
+			return false;
+		};
+
+		if (Header->Ready.load(std::memory_order_acquire) != 1) return fail("创建者尚未完成初始化");
+		if (const auto reason = CheckItemHeader(*Header, itemSize, typeHash); !reason.empty()) return fail(reason);
+
+		RecoverAbandonedSlots();
+		return true;
+	}
+
+	void SharedTripleByteBuffer::Close() noexcept {
+		if (Header == nullptr) return;
+		::munmap(Header, MappedSize);
+		if (IsCreator) ::shm_unlink(Name.c_str());
+		Header = nullptr;
+		Items = nullptr;
+		MappedSize = 0;
+		IsCreator = false;
+	}
+
+	std::uint64_t SharedTripleByteBuffer::GetBusyStatus() const noexcept {
+		return ProcessID << 8 | Protocol::Busy;
+	}
+
+	std::size_t SharedTripleByteBuffer::RecoverAbandonedSlots() noexcept {
+		std::size_t count = 0;
+		for (auto& status : Header->StatusList) {
+			auto current = status.load(std::memory_order_acquire);
+			if ((current & Protocol::StatusMask) != Protocol::Busy) continue;
+
+			const auto owner = current >> 8;
+			if (owner == ProcessID || !IsProcessDead(owner)) continue;
+
+			// 持有者在写入或读取的中途退出，槽位中的数据不完整，直接丢弃
+			if (status.compare_exchange_strong(current, Protocol::Empty, std::memory_order_acq_rel)) ++count;
+		}
+		return count;
+	}
+
+	void SharedTripleByteBuffer::WriteBytes(const void* data) noexcept {
+		// 只有一个读取者时不会出现所有槽位都被占用的情况，除非有进程持有槽位时退出了
+		const auto index = Protocol::AcquireWrite(
+			Header->WriterIndex, Header->StatusList, GetBusyStatus(), [this] { RecoverAbandonedSlots(); });
+		std::memcpy(Items + index * Header->ItemStride, data, Header->ItemSize);
+		Protocol::PublishWrite(Header->WriterIndex, Header->StatusList, index);
+	}
+
+	bool SharedTripleByteBuffer::ReadBytes(void* data) noexcept {
+		std::uint32_t index = 0;
+		if (!Protocol::AcquireRead(Header->WriterIndex, Header->StatusList, GetBusyStatus(), index)) return false;
+		std::memcpy(data, Items + index * Header->ItemStride, Header->ItemSize);
+		Protocol::ReleaseRead(Header->StatusList, index);
+		return true;
+	}
+}
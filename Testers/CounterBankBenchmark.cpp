@@ -0,0 +1,83 @@
+/// 对比 CounterBank 与逐个调用 CounterX 的耗时，并检查二者的结果一致
+#include <Cango/CommonUtils/CounterBank.hpp>
+#include <Cango/CommonUtils/CounterX.hpp>
+#include <chrono>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include <fmt/format.h>
+
+namespace {
+	using namespace Cango;
+	using Clock = std::chrono::steady_clock;
+
+	constexpr std::size_t FrameCount = 200;
+
+	/// 模拟看门狗：每帧先对所有计数器计数，再重置本帧观测到的目标
+	template <typename TNumber>
+	bool Run(const std::size_t counterCount) {
+		std::mt19937 random{42};
+		std::uniform_int_distribution<int> max_distribution{1, 20};
+		std::bernoulli_distribution seen_distribution{0.7};
+
+		std::vector<CounterX<TNumber>> counters(counterCount);
+		CounterBank<TNumber> bank{counterCount};
+		for (std::size_t index = 0; index < counterCount; ++index) {
+			const auto max_count = static_cast<TNumber>(max_distribution(random));
+			counters[index].MaxCount = max_count;
+			bank.SetMaxCount(index, max_count);
+		}
+
+		std::vector<std::vector<typename CounterBank<TNumber>::MaskWord>> seen_frames(FrameCount);
+		for (auto& seen : seen_frames) {
+			seen.resize(bank.GetMaskWordCount());
+			for (std::size_t index = 0; index < counterCount; ++index)
+				if (seen_distribution(random)) seen[index / 64] |= std::uint64_t{1} << index % 64;
+		}
+
+		std::vector<std::uint64_t> scalar_mask(bank.GetMaskWordCount());
+		std::vector<std::uint64_t> bank_mask(bank.GetMaskWordCount());
+		std::size_t scalar_total = 0;
+		std::size_t bank_total = 0;
+		bool is_same = true;
+		Clock::duration scalar_duration{};
+		Clock::duration bank_duration{};
+
+		for (const auto& seen : seen_frames) {
+			auto begin = Clock::now();
+			std::ranges::fill(scalar_mask, 0);
+			for (std::size_t index = 0; index < counterCount; ++index)
+				if (counters[index].Count()) scalar_mask[index / 64] |= std::uint64_t{1} << index % 64;
+			CounterBank<TNumber>::ForEachSelected(seen, [&counters](const std::size_t index) { counters[index].Reset(); });
+			scalar_duration += Clock::now() - begin;
+
+			begin = Clock::now();
+			bank_total += bank.CountAll(bank_mask);
+			bank.ResetSelected(seen);
+			bank_duration += Clock::now() - begin;
+
+			for (const auto word : scalar_mask) scalar_total += static_cast<std::size_t>(std::popcount(word));
+			is_same = is_same && scalar_mask == bank_mask;
+		}
+
+		const auto per_frame = [](const Clock::duration duration) {
+			return std::chrono::duration<double, std::micro>(duration).count() / FrameCount;
+		};
+		fmt::print("{}{:>2} 位 {:>6} 个计数器 CounterX {:8.2f}us/帧 CounterBank {:8.2f}us/帧 加速 {:5.1f}x 到达 {} {}\n",
+			std::is_signed_v<TNumber> ? 'i' : 'u', sizeof(TNumber) * 8, counterCount, per_frame(scalar_duration), per_frame(bank_duration),
+			per_frame(scalar_duration) / per_frame(bank_duration), bank_total, is_same && scalar_total == bank_total ? "一致" : "不一致");
+		return is_same;
+	}
+}
+
+int main() {
+	bool is_same = true;
+	for (const std::size_t count : {1000, 1003, 10000, 100000}) {
+		is_same = Run<std::uint8_t>(count) && is_same;
+		is_same = Run<std::uint16_t>(count) && is_same;
+		is_same = Run<std::uint32_t>(count) && is_same;
+		is_same = Run<std::uint64_t>(count) && is_same;
+		is_same = Run<std::int32_t>(count) && is_same;
+	}
+	return is_same ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+/// 对比协程事件循环与每个循环一个线程的切换延迟、周期任务的抖动和开销
+#include <Cango/CommonUtils/EventLoop.hpp>
+#include <Cango/CommonUtils/IntervalSleeper.hpp>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <fmt/format.h>
+#include <sys/resource.h>
+
+namespace {
+	using namespace Cango;
+	using Clock = std::chrono::steady_clock;
+
+	constexpr std::size_t RoundTripCount = 100000;
+	constexpr std::size_t PeriodicTaskCount = 200;
+	constexpr std::chrono::milliseconds PeriodicInterval{1};
+	constexpr std::chrono::seconds PeriodicDuration{1};
+
+	struct Usage {
+		double CPUSeconds{};
+		long ContextSwitches{};
+
+		static Usage Now() noexcept {
+			rusage usage{};
+			getrusage(RUSAGE_SELF, &usage);
+			const auto seconds = [](const timeval& time) { return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_usec) / 1e6; };
+			return {seconds(usage.ru_utime) + seconds(usage.ru_stime), usage.ru_nvcsw + usage.ru_nivcsw};
+		}
+
+		Usage operator-(const Usage& other) const noexcept {
+			return {CPUSeconds - other.CPUSeconds, ContextSwitches - other.ContextSwitches};
+		}
+	};
+
+	/// 记录周期任务的实际间隔与期望间隔的偏差
+	struct JitterRecorder {
+		Clock::time_point LastTick{};
+		double DeviationSum{0};
+		std::size_t TickCount{0};
+
+		void Tick() noexcept {
+			const auto now = Clock::now();
+			if (TickCount++ > 0) {
+				const auto interval = std::chrono::duration<double, std::micro>(now - LastTick).count();
+				DeviationSum += std::abs(interval - std::chrono::duration<double, std::micro>(PeriodicInterval).count());
+			}
+			LastTick = now;
+		}
+	};
+
+	void PrintPeriodic(const std::string_view name, const std::vector<JitterRecorder>& recorders, const Usage& usage) {
+		double deviation = 0;
+		std::size_t ticks = 0;
+		for (const auto& recorder : recorders) {
+			deviation += recorder.DeviationSum;
+			ticks += recorder.TickCount;
+		}
+		fmt::print("{:<12} {} 个周期任务 共 {} 次 平均偏差 {:.1f}us CPU {:.3f}s 上下文切换 {}\n",
+			name, recorders.size(), ticks, deviation / static_cast<double>(ticks), usage.CPUSeconds, usage.ContextSwitches);
+	}
+
+	LoopTask Pinger(CoroutineItemPool<std::uint64_t>& ping, CoroutineItemPool<std::uint64_t>& pong, EventLoop& loop) {
+		const auto begin = Clock::now();
+		for (std::uint64_t sequence = 0; sequence < RoundTripCount; ++sequence) {
+			ping.SetItem(sequence);
+			while (co_await pong.NextItem() != sequence) {}
+		}
+		const auto duration = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+		fmt::print("{:<12} 往返 {:.0f}ns\n", "协程", duration / RoundTripCount);
+		loop.Stop();
+	}
+
+	LoopTask Ponger(CoroutineItemPool<std::uint64_t>& ping, CoroutineItemPool<std::uint64_t>& pong) {
+		while (true) pong.SetItem(co_await ping.NextItem());
+	}
+
+	void RunCoroutinePingPong() {
+		EventLoop loop{};
+		CoroutineItemPool<std::uint64_t> ping{loop};
+		CoroutineItemPool<std::uint64_t> pong{loop};
+		if (!loop.Initialize() || !ping.Initialize() || !pong.Initialize()) return;
+		loop.Spawn(Ponger(ping, pong));
+		loop.Spawn(Pinger(ping, pong, loop));
+		loop.Run();
+	}
+
+	/// 每个循环一个线程，没有物品时通过 futex 阻塞
+	void RunThreadPingPong() {
+		TripleItemPool<std::uint64_t> ping{};
+		TripleItemPool<std::uint64_t> pong{};
+		std::atomic_uint64_t ping_version{0};
+		std::atomic_uint64_t pong_version{0};
+
+		const auto wait = [](TripleItemPool<std::uint64_t>& pool, std::atomic_uint64_t& version, std::uint64_t& item) {
+			while (true) {
+				const auto current = version.load();
+				if (pool.GetItem(item)) return;
+				version.wait(current);
+			}
+		};
+		const auto set = [](TripleItemPool<std::uint64_t>& pool, std::atomic_uint64_t& version, const std::uint64_t item) {
+			pool.SetItem(item);
+			version.fetch_add(1);
+			version.notify_one();
+		};
+
+		std::thread ponger{[&] {
+			std::uint64_t item{};
+			do {
+				wait(ping, ping_version, item);
+				set(pong, pong_version, item);
+			}
+			while (item + 1 < RoundTripCount);
+		}};
+
+		const auto begin = Clock::now();
+		for (std::uint64_t sequence = 0; sequence < RoundTripCount; ++sequence) {
+			set(ping, ping_version, sequence);
+			std::uint64_t item{};
+			do wait(pong, pong_version, item); while (item != sequence);
+		}
+		const auto duration = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+		ponger.join();
+		fmt::print("{:<12} 往返 {:.0f}ns\n", "线程", duration / RoundTripCount);
+	}
+
+	LoopTask PeriodicTask(EventLoop& loop, JitterRecorder& recorder, const Clock::time_point end) {
+		CoroutineIntervalSleeper sleeper{loop, PeriodicInterval};
+		while (Clock::now() < end) {
+			co_await sleeper.NextTick();
+			recorder.Tick();
+		}
+	}
+
+	void RunCoroutinePeriodic() {
+		EventLoop loop{};
+		if (!loop.Initialize()) return;
+		std::vector<JitterRecorder> recorders(PeriodicTaskCount);
+		const auto end = Clock::now() + PeriodicDuration;
+		for (auto& recorder : recorders) loop.Spawn(PeriodicTask(loop, recorder, end));
+
+		const auto before = Usage::Now();
+		loop.Run();
+		PrintPeriodic("协程", recorders, Usage::Now() - before);
+	}
+
+	void RunThreadPeriodic() {
+		std::vector<JitterRecorder> recorders(PeriodicTaskCount);
+		std::vector<std::thread> threads{};
+		const auto end = Clock::now() + PeriodicDuration;
+
+		const auto before = Usage::Now();
+		for (auto& recorder : recorders) {
+			threads.emplace_back([&recorder, end] {
+				IntervalSleeper sleeper{PeriodicInterval};
+				while (Clock::now() < end) {
+					sleeper.Sleep();
+					recorder.Tick();
+				}
+			});
+		}
+		for (auto& thread : threads) thread.join();
+		PrintPeriodic("线程", recorders, Usage::Now() - before);
+	}
+}
+
+int main() {
+	RunCoroutinePingPong();
+	RunThreadPingPong();
+	RunCoroutinePeriodic();
+	RunThreadPeriodic();
+	return 0;
+}
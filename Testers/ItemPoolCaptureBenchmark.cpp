@@ -0,0 +1,92 @@
+/// 测量捕获对 SetItem GetItem 的额外开销，并以原速和加速回放捕获的物品
+#include <Cango/CommonUtils/ItemPoolCapture.hpp>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <boost/filesystem/operations.hpp>
+#include <fmt/format.h>
+
+namespace {
+	using namespace Cango;
+	using Clock = std::chrono::steady_clock;
+
+	struct Pose {
+		std::uint64_t Frame{};
+		std::array<double, 6> Values{};
+	};
+
+	constexpr std::size_t OperationCount = 1000000;
+	constexpr std::size_t ReplayFrameCount = 200;
+	constexpr std::chrono::milliseconds ReplayInterval{2};
+
+	double MeasureNanoseconds(CapturedTripleItemPool<Pose>& pool) {
+		Pose item{};
+		std::size_t received = 0;
+		const auto begin = Clock::now();
+		for (std::uint64_t frame = 0; frame < OperationCount; ++frame) {
+			item.Frame = frame;
+			pool.SetItem(item);
+			if (pool.GetItem(item)) ++received;
+		}
+		const auto duration = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+		return received == OperationCount ? duration / OperationCount : -1;
+	}
+
+	/// 统计回放时读取者收到的物品数量
+	struct CountingPool {
+		std::size_t Count{0};
+		std::uint64_t LastFrame{0};
+
+		void SetItem(const Pose& item) noexcept {
+			++Count;
+			LastFrame = item.Frame;
+		}
+	};
+
+	bool Run(const boost::filesystem::path& directory) {
+		auto& logger = *spdlog::default_logger();
+		const auto capture_file = directory / "capture_benchmark.bin";
+		const auto replay_file = directory / "capture_replay.bin";
+
+		CapturedTripleItemPool<Pose> plain{};
+		fmt::print("未捕获     每次写入并读取 {:.1f}ns\n", MeasureNanoseconds(plain));
+
+		CapturedTripleItemPool<Pose> captured{};
+		if (!captured.StartCapture(logger, capture_file, OperationCount * 2)) return false;
+		// 第一轮包含首次访问映射页面的缺页开销，第二轮覆盖环形缓冲区中已经驻留的页面
+		fmt::print("捕获(首轮) 每次写入并读取 {:.1f}ns\n", MeasureNanoseconds(captured));
+		fmt::print("捕获(覆盖) 每次写入并读取 {:.1f}ns\n", MeasureNanoseconds(captured));
+		captured.StopCapture();
+
+		// 以固定间隔捕获一段较短的数据用于回放
+		if (!captured.StartCapture(logger, replay_file, ReplayFrameCount * 2)) return false;
+		for (std::uint64_t frame = 0; frame < ReplayFrameCount; ++frame) {
+			captured.SetItem(Pose{frame, {}});
+			std::this_thread::sleep_for(ReplayInterval);
+		}
+		captured.StopCapture();
+
+		ItemPoolReplayer<Pose> replayer{};
+		if (!replayer.Open(logger, replay_file)) return false;
+		for (const double speed : {1.0, 4.0, 0.0}) {
+			CountingPool pool{};
+			const auto begin = Clock::now();
+			const auto count = replayer.Replay(pool, speed);
+			const auto duration = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+			fmt::print("回放 速度 {} 物品 {} 最后一帧 {} 耗时 {:.1f}ms\n", speed, count, pool.LastFrame, duration);
+		}
+		return true;
+	}
+}
+
+int main() {
+	// 捕获文件较大，写入临时目录并在退出前删除
+	const auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("cango-capture-%%%%%%");
+	boost::filesystem::create_directories(directory);
+
+	const bool is_done = Run(directory);
+
+	boost::system::error_code error{};
+	boost::filesystem::remove_all(directory, error);
+	return is_done ? 0 : 1;
+}
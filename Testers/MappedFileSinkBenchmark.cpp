@@ -0,0 +1,100 @@
+/// 对比内存映射日志输出与 spdlog 的滚动文件输出的吞吐量和每条日志的耗时，并检查进程崩溃后日志是否完整
+#include <Cango/CommonUtils/MappedFileSink.hpp>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <boost/filesystem/operations.hpp>
+#include <fmt/format.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../Benchmarks/BenchmarkHarness.hpp"
+
+namespace {
+	using namespace Cango;
+	using Cango::Benchmarks::Percentile;
+	using Clock = std::chrono::steady_clock;
+
+	constexpr std::size_t MessageCount = 500000;
+	constexpr std::size_t CrashMessageCount = 100000;
+	constexpr std::size_t SegmentSize = 5 * 1024 * 1024;
+
+	/// 使用与默认日志器相同的格式，逐条记录耗时
+	void RunBenchmark(const std::string_view name, const std::shared_ptr<spdlog::sinks::sink>& sink) {
+		spdlog::logger logger{"benchmark", sink};
+		logger.set_level(spdlog::level::trace);
+
+		std::vector<double> samples{};
+		samples.reserve(MessageCount);
+
+		const auto begin = Clock::now();
+		for (std::size_t index = 0; index < MessageCount; ++index) {
+			const auto message_begin = Clock::now();
+			logger.info("Benchmark> 第 {} 条日志，附带一些典型的负载 {:.3f} {}", index, static_cast<double>(index) * 0.5, "detection");
+			samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - message_begin).count());
+		}
+		logger.flush();
+		const auto seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+		std::ranges::sort(samples);
+		fmt::print("{:<20} {:>10.0f} 条/s p50 {:>6.0f}ns p99 {:>7.0f}ns p999 {:>8.0f}ns max {:>9.0f}ns\n",
+			name, static_cast<double>(MessageCount) / seconds, Percentile(samples, 0.5), Percentile(samples, 0.99),
+			Percentile(samples, 0.999), samples.back());
+	}
+
+	/// 子进程写入日志后直接被 SIGKILL 终止，父进程使用相同的名称重新打开之后，统计留在文件中的日志行数
+	void RunCrashTest(const boost::filesystem::path& directory) {
+		const auto base_name = (directory / "crash_").string();
+		const pid_t child = ::fork();
+		if (child == 0) {
+			const auto sink = std::make_shared<MappedFileSinkST>();
+			if (!sink->Open({base_name, SegmentSize, false})) ::_exit(1);
+			spdlog::logger logger{"crash", sink};
+			for (std::size_t index = 0; index < CrashMessageCount; ++index) logger.info("Crash> 第 {} 条日志", index);
+			::kill(::getpid(), SIGKILL);
+		}
+
+		int status = 0;
+		::waitpid(child, &status, 0);
+
+		// 重新打开时接在崩溃留下的分段之后编号，不会覆盖它们
+		if (const auto sink = std::make_shared<MappedFileSinkST>(); sink->Open({base_name, SegmentSize, false})) {
+			spdlog::logger logger{"reopen", sink};
+			logger.info("Reopen> 重新打开");
+		}
+
+		std::size_t line_count = 0;
+		for (const auto& entry : boost::filesystem::directory_iterator{directory}) {
+			if (entry.path().filename().string().rfind("crash_", 0) != 0) continue;
+			std::ifstream file{entry.path().string()};
+			for (std::string line{}; std::getline(file, line);) if (line.find("Crash>") != std::string::npos) ++line_count;
+		}
+		fmt::print("SIGKILL 之后保留了 {}/{} 条日志\n", line_count, CrashMessageCount);
+	}
+}
+
+int main() {
+	const auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("cango-log-%%%%%%");
+	boost::filesystem::create_directories(directory);
+
+	RunBenchmark("rotating_file_sink", std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
+		(directory / "rotating.log").string(), SegmentSize, 0xffff, true));
+
+	// 输出在离开作用域时关闭，等待后台线程处理完关闭的分段之后再删除目录
+	{
+		const auto mapped = std::make_shared<MappedFileSinkMT>();
+		if (mapped->Open({(directory / "mapped_").string(), SegmentSize, false})) RunBenchmark("MappedFileSink", mapped);
+
+		const auto compressed = std::make_shared<MappedFileSinkMT>();
+		if (compressed->Open({(directory / "compressed_").string(), SegmentSize, true})) RunBenchmark("MappedFileSink+gzip", compressed);
+	}
+
+	RunCrashTest(directory);
+
+	boost::system::error_code error{};
+	boost::filesystem::remove_all(directory, error);
+	return 0;
+}
@@ -0,0 +1,92 @@
+/// 测量指标更新的开销，并与 CounterX 和 CallRateCounterX 对比，最后从共享内存读取导出的快照
+#include <Cango/CommonUtils/CallRateCounterX.hpp>
+#include <Cango/CommonUtils/CounterX.hpp>
+#include <Cango/CommonUtils/MetricsRegistry.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <boost/filesystem/operations.hpp>
+#include <fmt/format.h>
+#include "../Benchmarks/BenchmarkHarness.hpp"
+
+namespace {
+	using namespace Cango;
+	using Cango::Benchmarks::DoNotOptimize;
+	using Clock = std::chrono::steady_clock;
+
+	constexpr std::size_t OperationCount = 10000000;
+
+	void Measure(const std::string_view name, auto&& operation) {
+		const auto begin = Clock::now();
+		for (std::size_t index = 0; index < OperationCount; ++index) operation(index);
+		const auto duration = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+		fmt::print("{:<28} 每次 {:.2f}ns\n", name, duration / OperationCount);
+	}
+
+	void MeasureThreads(const std::string_view name, const std::size_t threadCount, auto&& operation) {
+		std::vector<std::thread> threads{};
+		const auto begin = Clock::now();
+		for (std::size_t thread = 0; thread < threadCount; ++thread)
+			threads.emplace_back([&operation] { for (std::size_t index = 0; index < OperationCount; ++index) operation(index); });
+		for (auto& thread : threads) thread.join();
+		const auto duration = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+		fmt::print("{:<28} {} 线程 每次 {:.2f}ns\n", name, threadCount, duration / OperationCount / threadCount);
+	}
+}
+
+int main() {
+	auto& registry = MetricsRegistry::Instance();
+	const auto counter = registry.RegisterCounter("benchmark_counter");
+	const auto rate = registry.RegisterRate("benchmark_rate");
+	const auto gauge = registry.RegisterGauge("benchmark_gauge");
+	const auto histogram = registry.RegisterHistogram("benchmark_latency_ns");
+
+	Counter64 counter_x{0, ~0ull};
+	Measure("CounterX::Count", [&](std::size_t) { DoNotOptimize(counter_x.Count()); });
+	Measure("MetricCounter::Add", [&](std::size_t) { counter.Add(); });
+
+	CallRateCounter64 call_rate{};
+	Measure("CallRateCounterX::Call", [&](std::size_t) { DoNotOptimize(call_rate.Call()); });
+	Measure("MetricRate::Call", [&](std::size_t) { rate.Call(); });
+
+	Measure("MetricGauge::Set", [&](const std::size_t index) { gauge.Set(static_cast<double>(index)); });
+	Measure("MetricHistogram::Record", [&](const std::size_t index) { histogram.Record(index & 0xffff); });
+
+	MeasureThreads("MetricCounter::Add", 4, [&](std::size_t) { counter.Add(); });
+	MeasureThreads("MetricHistogram::Record", 4, [&](const std::size_t index) { histogram.Record(index & 0xffff); });
+
+	// Prometheus 文件写入临时目录，退出前删除
+	const auto directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("cango-metrics-%%%%%%");
+	boost::filesystem::create_directories(directory);
+	const auto remove_directory = [&directory] {
+		boost::system::error_code error{};
+		boost::filesystem::remove_all(directory, error);
+	};
+
+	// 清理之前崩溃时遗留的共享内存，同名的共享内存存在时导出器无法启动
+	if (!MetricsExporter::Remove(*spdlog::default_logger(), "/cango_metrics_benchmark")) return 1;
+	MetricsExporter exporter{};
+	if (!exporter.Start({"/cango_metrics_benchmark", directory / "metrics_benchmark.prom", std::chrono::milliseconds{100}})) {
+		remove_directory();
+		return 1;
+	}
+	if (MetricsExporter second{}; second.Start({"/cango_metrics_benchmark", {}, std::chrono::milliseconds{100}})) {
+		fmt::print("第二个导出器接管了正在使用的共享内存\n");
+		exporter.Stop();
+		remove_directory();
+		return 1;
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds{250});
+
+	MetricsSnapshot snapshot{};
+	const bool is_read = ReadMetricsSnapshot(*spdlog::default_logger(), "/cango_metrics_benchmark", snapshot);
+	if (is_read) {
+		for (std::size_t index = 0; index < snapshot.Count; ++index) {
+			const auto& entry = snapshot.Entries[index];
+			fmt::print("快照 {:<24} 次数 {} 数值 {}\n", entry.Name.data(), entry.Count, entry.Value);
+		}
+	}
+	exporter.Stop();
+	remove_directory();
+	return is_read ? 0 : 1;
+}
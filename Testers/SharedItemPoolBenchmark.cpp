@@ -0,0 +1,197 @@
+/// 对比 SharedTripleItemPool 与 Unix 域套接字在两个进程之间传递物品的延迟和吞吐量。
+/// 吞吐量按读取者收到的物品计算，写入端开销单独列出
+#include <Cango/CommonUtils/SharedItemPool.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include <fmt/format.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../Benchmarks/BenchmarkHarness.hpp"
+
+namespace {
+	using namespace Cango;
+	using Cango::Benchmarks::Percentile;
+	using Clock = std::chrono::steady_clock;
+
+	struct BenchmarkItem {
+		std::uint64_t Sequence{};
+		std::array<float, 62> Payload{};
+	};
+
+	constexpr std::size_t RoundTripCount = 20000;
+	constexpr std::size_t ThroughputCount = 200000;
+	constexpr std::uint64_t StopSequence = ~0ull;
+
+	void PrintLatency(const std::string_view name, std::vector<std::int64_t>& samples) {
+		std::ranges::sort(samples);
+		fmt::print("{:<24} 往返延迟(ns) p50={} p90={} p99={} max={}\n",
+			name, Percentile(samples, 0.5), Percentile(samples, 0.9), Percentile(samples, 0.99), samples.back());
+	}
+
+	/// 吞吐量按读取者实际收到的物品计算，三重缓冲区会丢弃较旧的物品，写入的速率并不等于交付的速率
+	void PrintThroughput(
+		const std::string_view name,
+		const std::size_t written,
+		const std::size_t delivered,
+		const Clock::duration duration) {
+		const auto seconds = std::chrono::duration<double>(duration).count();
+		fmt::print("{:<24} 交付吞吐量 {:.0f} 物品/s ({:.1f} MB/s) 读取者收到 {}/{} 个物品\n",
+			name, delivered / seconds, delivered * sizeof(BenchmarkItem) / seconds / 1e6, delivered, written);
+	}
+
+	/// 写入者每写入一个物品的平均耗时，只反映写入端的开销
+	void PrintWriterCost(const std::string_view name, const std::size_t written, const Clock::duration duration) {
+		fmt::print("{:<24} 写入端开销 {:.1f}ns/物品\n",
+			name, std::chrono::duration<double, std::nano>(duration).count() / written);
+	}
+
+	/// 自旋等待时让出处理器，避免在核心数较少的机器上饿死对端进程
+	template <typename TPool>
+	void WaitItem(TPool& pool, BenchmarkItem& item) {
+		while (!pool.GetItem(item)) sched_yield();
+	}
+
+	void RunSharedMemory() {
+		constexpr std::string_view ping_name = "/cango_benchmark_ping";
+		constexpr std::string_view pong_name = "/cango_benchmark_pong";
+		auto& logger = *spdlog::default_logger();
+		SharedTripleByteBuffer::Remove(logger, ping_name);
+		SharedTripleByteBuffer::Remove(logger, pong_name);
+
+		SharedTripleItemPool<BenchmarkItem> ping{};
+		SharedTripleItemPool<BenchmarkItem> pong{};
+		if (!ping.Create(ping_name) || !pong.Create(pong_name)) std::exit(1);
+
+		const pid_t child = fork();
+		if (child == 0) {
+			SharedTripleItemPool<BenchmarkItem> child_ping{};
+			SharedTripleItemPool<BenchmarkItem> child_pong{};
+			if (!child_ping.Attach(ping_name) || !child_pong.Attach(pong_name)) std::_Exit(1);
+
+			BenchmarkItem item{};
+			do {
+				WaitItem(child_ping, item);
+				child_pong.SetItem(item);
+			}
+			while (item.Sequence != StopSequence);
+
+			// 吞吐量：只统计收到的最新物品，三重缓冲区允许丢弃较旧的物品
+			std::uint64_t received = 0;
+			while (true) {
+				WaitItem(child_ping, item);
+				if (item.Sequence == StopSequence) break;
+				++received;
+			}
+			item.Sequence = received;
+			child_pong.SetItem(item);
+			std::_Exit(0);
+		}
+
+		BenchmarkItem item{};
+		std::vector<std::int64_t> samples{};
+		samples.reserve(RoundTripCount);
+		for (std::uint64_t sequence = 0; sequence < RoundTripCount; ++sequence) {
+			const auto begin = Clock::now();
+			item.Sequence = sequence;
+			ping.SetItem(item);
+			do WaitItem(pong, item); while (item.Sequence != sequence);
+			samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count());
+		}
+		item.Sequence = StopSequence;
+		ping.SetItem(item);
+		do WaitItem(pong, item); while (item.Sequence != StopSequence);
+		PrintLatency("SharedTripleItemPool", samples);
+
+		const auto begin = Clock::now();
+		for (std::uint64_t sequence = 0; sequence < ThroughputCount; ++sequence) {
+			item.Sequence = sequence;
+			ping.SetItem(item);
+		}
+		const auto written = Clock::now();
+		item.Sequence = StopSequence;
+		ping.SetItem(item);
+		WaitItem(pong, item);
+		PrintThroughput("SharedTripleItemPool", ThroughputCount, item.Sequence, Clock::now() - begin);
+		PrintWriterCost("SharedTripleItemPool", ThroughputCount, written - begin);
+
+		waitpid(child, nullptr, 0);
+	}
+
+	bool WriteAll(const int fd, const BenchmarkItem& item) {
+		const auto* bytes = reinterpret_cast<const char*>(&item);
+		for (std::size_t done = 0; done < sizeof(item);) {
+			const auto result = write(fd, bytes + done, sizeof(item) - done);
+			if (result <= 0) return false;
+			done += static_cast<std::size_t>(result);
+		}
+		return true;
+	}
+
+	bool ReadAll(const int fd, BenchmarkItem& item) {
+		auto* bytes = reinterpret_cast<char*>(&item);
+		for (std::size_t done = 0; done < sizeof(item);) {
+			const auto result = read(fd, bytes + done, sizeof(item) - done);
+			if (result <= 0) return false;
+			done += static_cast<std::size_t>(result);
+		}
+		return true;
+	}
+
+	void RunUnixSocket() {
+		int fds[2];
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1) std::exit(1);
+
+		const pid_t child = fork();
+		if (child == 0) {
+			close(fds[0]);
+			BenchmarkItem item{};
+			while (ReadAll(fds[1], item) && item.Sequence != StopSequence) WriteAll(fds[1], item);
+			std::uint64_t received = 0;
+			while (ReadAll(fds[1], item) && item.Sequence != StopSequence) ++received;
+			item.Sequence = received;
+			WriteAll(fds[1], item);
+			std::_Exit(0);
+		}
+		close(fds[1]);
+
+		BenchmarkItem item{};
+		std::vector<std::int64_t> samples{};
+		samples.reserve(RoundTripCount);
+		for (std::uint64_t sequence = 0; sequence < RoundTripCount; ++sequence) {
+			const auto begin = Clock::now();
+			item.Sequence = sequence;
+			WriteAll(fds[0], item);
+			ReadAll(fds[0], item);
+			samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count());
+		}
+		item.Sequence = StopSequence;
+		WriteAll(fds[0], item);
+		PrintLatency("UnixDomainSocket", samples);
+
+		const auto begin = Clock::now();
+		for (std::uint64_t sequence = 0; sequence < ThroughputCount; ++sequence) {
+			item.Sequence = sequence;
+			WriteAll(fds[0], item);
+		}
+		const auto written = Clock::now();
+		item.Sequence = StopSequence;
+		WriteAll(fds[0], item);
+		ReadAll(fds[0], item);
+		PrintThroughput("UnixDomainSocket", ThroughputCount, item.Sequence, Clock::now() - begin);
+		PrintWriterCost("UnixDomainSocket", ThroughputCount, written - begin);
+
+		close(fds[0]);
+		waitpid(child, nullptr, 0);
+	}
+}
+
+int main() {
+	RunSharedMemory();
+	RunUnixSocket();
+	return 0;
+}
@@ -0,0 +1,125 @@
+/// 统计 TripleItemPool 在传递持有堆内存的物品时，每帧发生的内存分配次数和耗时
+#include <Cango/CommonUtils/AsyncItemPool.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fmt/format.h>
+
+namespace {
+	std::atomic_size_t AllocationCount{0};
+}
+
+void* operator new(const std::size_t size) {
+	AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+namespace {
+	using namespace Cango;
+	using Clock = std::chrono::steady_clock;
+
+	struct Box {
+		float X{}, Y{}, Width{}, Height{}, Score{};
+	};
+
+	struct DetectionList {
+		std::uint64_t Frame{};
+		std::string Source{};
+		std::vector<Box> Boxes{};
+	};
+
+	constexpr std::size_t WarmupFrameCount = 100;
+	constexpr std::size_t FrameCount = 100000;
+
+	void Fill(DetectionList& list, const std::uint64_t frame) {
+		list.Frame = frame;
+		list.Source.assign("front_camera_with_a_long_enough_name");
+		list.Boxes.clear();
+		for (std::size_t i = 0; i < 64 + frame % 64; ++i) list.Boxes.push_back({1, 2, 3, 4, 0.5f});
+	}
+
+	/// 单线程交替写入与读取，使分配次数的统计结果稳定
+	template <typename TWrite>
+	void RunSingleThread(const std::string_view name, TWrite write) {
+		TripleItemPool<DetectionList> pool{};
+		DetectionList writer_item{};
+		DetectionList reader_item{};
+		std::uint64_t checksum = 0;
+
+		const auto run = [&](const std::size_t count) {
+			for (std::uint64_t frame = 0; frame < count; ++frame) {
+				write(pool, writer_item, frame);
+				if (pool.GetItem(reader_item)) checksum += reader_item.Boxes.size();
+			}
+		};
+
+		run(WarmupFrameCount);
+		const auto allocations = AllocationCount.load();
+		const auto begin = Clock::now();
+		run(FrameCount);
+		const auto duration = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+		fmt::print("{:<16} 单线程 每帧分配 {:.3f} 次 每帧 {:.1f}ns (校验 {})\n",
+			name, static_cast<double>(AllocationCount.load() - allocations) / FrameCount, duration / FrameCount, checksum);
+	}
+
+	template <typename TWrite>
+	void RunTwoThreads(const std::string_view name, TWrite write) {
+		TripleItemPool<DetectionList> pool{};
+		std::atomic_bool stop{false};
+		std::size_t received = 0;
+
+		std::thread reader{[&] {
+			DetectionList item{};
+			while (!stop.load(std::memory_order_relaxed)) {
+				if (pool.GetItem(item)) ++received;
+				else std::this_thread::yield();
+			}
+		}};
+
+		DetectionList item{};
+		const auto allocations = AllocationCount.load();
+		const auto begin = Clock::now();
+		for (std::uint64_t frame = 0; frame < FrameCount; ++frame) write(pool, item, frame);
+		const auto duration = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+		stop = true;
+		reader.join();
+		fmt::print("{:<16} 双线程 每帧分配 {:.3f} 次 每帧 {:.1f}ns 读取 {} 帧\n",
+			name, static_cast<double>(AllocationCount.load() - allocations) / FrameCount, duration / FrameCount, received);
+	}
+
+	void Run(const std::string_view name, auto write) {
+		RunSingleThread(name, write);
+		RunTwoThreads(name, write);
+	}
+}
+
+int main() {
+	// 每帧重新构造物品，相当于把物品序列化到新的堆内存中
+	Run("重新构造", [](auto& pool, DetectionList&, const std::uint64_t frame) {
+		DetectionList fresh{};
+		Fill(fresh, frame);
+		pool.SetItem(std::move(fresh));
+	});
+
+	// 复制写入，槽位通过赋值复用容量
+	Run("复制写入", [](auto& pool, DetectionList& item, const std::uint64_t frame) {
+		Fill(item, frame);
+		pool.SetItem(item);
+	});
+
+	// 交换写入，写入者取回旧物品复用容量
+	Run("交换写入", [](auto& pool, DetectionList& item, const std::uint64_t frame) {
+		Fill(item, frame);
+		pool.ExchangeItem(item);
+	});
+	return 0;
+}
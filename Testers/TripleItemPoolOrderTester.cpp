@@ -0,0 +1,127 @@
+/// 检查三重缓冲池的读取顺序：读取者不会在读到新物品之后再读到旧物品，发现倒退时返回非零。
+/// 同时检查复制抛出异常后槽位被释放，数据池仍然可用
+#include <Cango/CommonUtils/AsyncItemPool.hpp>
+#include <Cango/CommonUtils/SharedItemPool.hpp>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <fmt/format.h>
+
+namespace {
+	using namespace Cango;
+
+	constexpr std::uint64_t WriteCount = 2000000;
+
+	struct ObjectItem {
+		std::uint64_t Sequence{};
+		std::vector<std::uint64_t> Values{};
+	};
+
+	/// 一个写入者写入递增的序号，一个读取者检查读到的序号是否严格递增
+	template <typename TItem>
+	std::size_t CountBackwardReads(const std::string_view name, auto& writer, auto& reader_pool) {
+		std::atomic_bool is_writing{true};
+		std::size_t backward_count = 0;
+		std::size_t read_count = 0;
+
+		std::thread reader{[&] {
+			TItem item{};
+			std::uint64_t last = 0;
+			while (true) {
+				const bool is_last_round = !is_writing.load(std::memory_order_acquire);
+				if (reader_pool.GetItem(item)) {
+					++read_count;
+					if (item.Sequence <= last) {
+						if (backward_count++ < 5) fmt::print("{:<12} 读到 {} 之后又读到 {}\n", name, last, item.Sequence);
+					}
+					else last = item.Sequence;
+				}
+				if (is_last_round) break;
+			}
+		}};
+
+		TItem item{};
+		for (std::uint64_t sequence = 1; sequence <= WriteCount; ++sequence) {
+			item.Sequence = sequence;
+			if constexpr (requires { item.Values; }) item.Values.assign(4, sequence);
+			writer.SetItem(item);
+		}
+		is_writing.store(false, std::memory_order_release);
+		reader.join();
+
+		fmt::print("{:<12} 写入 {} 次 读取 {} 次 倒退 {} 次\n", name, WriteCount, read_count, backward_count);
+		return backward_count;
+	}
+
+	struct PodItem {
+		std::uint64_t Sequence{};
+	};
+
+	/// 复制时按需抛出异常的物品，模拟分配内存失败
+	struct ThrowingItem {
+		static inline bool ShouldThrow = false;
+
+		std::uint64_t Sequence{};
+
+		ThrowingItem() noexcept = default;
+		ThrowingItem(const ThrowingItem&) = default;
+		ThrowingItem(ThrowingItem&&) noexcept = default;
+		ThrowingItem& operator=(ThrowingItem&&) noexcept = default;
+
+		ThrowingItem& operator=(const ThrowingItem& other) {
+			if (ShouldThrow) throw std::bad_alloc{};
+			Sequence = other.Sequence;
+			return *this;
+		}
+	};
+
+	/// 每次写入都抛出异常之后，槽位不能一直处于占用状态，之后的写入和读取仍然成功
+	bool CheckThrowingWrites() {
+		TripleItemPool<ThrowingItem> pool{};
+		static_assert(!TripleItemPool<ThrowingItem>::IsNothrowCopy);
+
+		ThrowingItem item{};
+		ThrowingItem::ShouldThrow = true;
+		std::size_t throw_count = 0;
+		for (std::uint64_t sequence = 1; sequence <= 10; ++sequence) {
+			item.Sequence = sequence;
+			try { pool.SetItem(item); }
+			catch (const std::bad_alloc&) { ++throw_count; }
+		}
+		ThrowingItem::ShouldThrow = false;
+
+		ThrowingItem result{};
+		const bool is_empty = !pool.GetItem(result);
+		item.Sequence = 11;
+		pool.SetItem(item);
+		const bool is_delivered = pool.GetItem(result) && result.Sequence == 11;
+
+		fmt::print("{:<12} 抛出 {} 次 之后{}\n", "异常写入", throw_count, is_empty && is_delivered ? "仍然可用" : "无法使用");
+		return throw_count == 10 && is_empty && is_delivered;
+	}
+}
+
+int main() {
+	std::size_t backward_count = 0;
+
+	TripleItemPool<PodItem> byte_pool{};
+	backward_count += CountBackwardReads<PodItem>("字节存储", byte_pool, byte_pool);
+
+	TripleItemPool<ObjectItem> object_pool{};
+	backward_count += CountBackwardReads<ObjectItem>("对象存储", object_pool, object_pool);
+
+	// 共享内存的两端在同一个进程中打开，使用与进程间相同的槽位协议
+	constexpr std::string_view shared_name = "/cango_triple_item_pool_order_tester";
+	SharedTripleItemPool<PodItem> shared_writer{};
+	SharedTripleItemPool<PodItem> shared_reader{};
+	if (!SharedTripleByteBuffer::Remove(*spdlog::default_logger(), shared_name) ||
+		!shared_writer.Create(shared_name) || !shared_reader.Attach(shared_name))
+		return 1;
+	backward_count += CountBackwardReads<PodItem>("共享内存", shared_writer, shared_reader);
+
+	if (!CheckThrowingWrites()) return 1;
+	return backward_count == 0 ? 0 : 1;
+}